@@ -0,0 +1,44 @@
+#include "Allocation_Counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// number of heap allocations since the program started
+static std::atomic<uint64_t> allocations(0);
+
+// number of heap allocations since the program started
+uint64_t allocation_count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// replacement global allocation functions (the array forms call these)
+void *operator new(std::size_t size) {
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    // zero byte requests still have to return a unique pointer
+    void *memory = std::malloc(size != 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+/* Counts every heap allocation made through operator new
+    - Allocation_Counter.cpp replaces the global operator new and delete, which every container and std::string allocates through
+    - Counting is one relaxed atomic increment per allocation, so it is always on
+*/
+
+uint64_t allocation_count(); // number of heap allocations since the program started
+
+#endif
@@ -0,0 +1,104 @@
+#include "Attitude.hpp"
+
+// constructor (identity attitude, local frame equals global frame)
+Attitude::Attitude() {
+    w = 1.0;
+    x = 0.0;
+    y = 0.0;
+    z = 0.0;
+}
+
+// constructor (quaternion components)
+Attitude::Attitude(double w, double x, double y, double z) {
+    this->w = w;
+    this->x = x;
+    this->y = y;
+    this->z = z;
+}
+
+// attitude change that rotates coordinates by angle about a unit axis (same as compute_axis_angle_matrix)
+Attitude Attitude::from_axis_angle(double axis_x, double axis_y, double axis_z, double angle) {
+
+    // half angle form of the rotation
+    double s = sin(angle / 2.0);
+    return Attitude(cos(angle / 2.0), axis_x * s, axis_y * s, axis_z * s);
+}
+
+// attitude change of a single roll, pitch, or yaw maneuver (same as compute_rotation_matrix)
+Attitude Attitude::from_maneuver(Maneuver_Axis axis, double angle) {
+
+    // the satellite turns by +angle about the maneuver axis, so coordinates turn by -angle (see compute_efficient_roll for the axis convention)
+    switch (axis) {
+        case Maneuver_Axis::Roll : return from_axis_angle(0.0, 0.0, 1.0, -angle);
+        case Maneuver_Axis::Pitch: return from_axis_angle(1.0, 0.0, 0.0, -angle);
+        case Maneuver_Axis::Yaw  : return from_axis_angle(0.0, 1.0, 0.0, -angle);
+    }
+    return Attitude();
+}
+
+// compose attitudes (other is applied first)
+Attitude Attitude::operator*(const Attitude &other) const {
+
+    // Hamilton product (16 multiplies, versus 27 for a rotation matrix product)
+    return Attitude(w * other.w - x * other.x - y * other.y - z * other.z,
+                    w * other.x + x * other.w + y * other.z - z * other.y,
+                    w * other.y - x * other.z + y * other.w + z * other.x,
+                    w * other.z + x * other.y - y * other.x + z * other.w);
+}
+
+// inverse attitude (conjugate, goes from local to global coordinates)
+Attitude Attitude::inverse() const {
+    return Attitude(w, -x, -y, -z);
+}
+
+// rescale to unit length (removes floating-point drift after many compositions)
+void Attitude::normalize() {
+
+    double length = sqrt(w * w + x * x + y * y + z * z);
+    w /= length;
+    x /= length;
+    y /= length;
+    z /= length;
+}
+
+// rotate global coordinates into local coordinates
+void Attitude::rotate(double &vx, double &vy, double &vz) const {
+
+    // v' = v + w*t + q x t, with t = 2 * (q x v)
+    double tx = 2.0 * (y * vz - z * vy);
+    double ty = 2.0 * (z * vx - x * vz);
+    double tz = 2.0 * (x * vy - y * vx);
+
+    double rx = vx + w * tx + (y * tz - z * ty);
+    double ry = vy + w * ty + (z * tx - x * tz);
+    double rz = vz + w * tz + (x * ty - y * tx);
+
+    vx = rx;
+    vy = ry;
+    vz = rz;
+}
+
+// rotate local coordinates back into global coordinates
+void Attitude::inverse_rotate(double &vx, double &vy, double &vz) const {
+
+    // same as rotate() with the conjugate quaternion
+    double tx = 2.0 * (z * vy - y * vz);
+    double ty = 2.0 * (x * vz - z * vx);
+    double tz = 2.0 * (y * vx - x * vy);
+
+    double rx = vx + w * tx - (y * tz - z * ty);
+    double ry = vy + w * ty - (z * tx - x * tz);
+    double rz = vz + w * tz - (x * ty - y * tx);
+
+    vx = rx;
+    vy = ry;
+    vz = rz;
+}
+
+// equivalent rotation matrix (global to local cartesian coords)
+void Attitude::to_rot_mat(double rot_mat[3][3]) const {
+
+    rot_mat[0][0] = 1.0 - 2.0 * (y * y + z * z); rot_mat[0][1] =       2.0 * (x * y - w * z); rot_mat[0][2] =       2.0 * (x * z + w * y);
+    rot_mat[1][0] =       2.0 * (x * y + w * z); rot_mat[1][1] = 1.0 - 2.0 * (x * x + z * z); rot_mat[1][2] =       2.0 * (y * z - w * x);
+    rot_mat[2][0] =       2.0 * (x * z - w * y); rot_mat[2][1] =       2.0 * (y * z + w * x); rot_mat[2][2] = 1.0 - 2.0 * (x * x + y * y);
+}
@@ -0,0 +1,44 @@
+#ifndef ATTITUDE_HPP
+#define ATTITUDE_HPP
+
+#include <cmath>
+#include "Helper_Functions.hpp"
+
+/* Unit quaternion attitude (value type)
+    - Rotates global cartesian coordinates into the satellite's local cartesian coordinates (same role as the old rotation matrix)
+    - Composition follows the rotation matrix order: (b * a) applies a first, then b
+    - Only the console needs a rotation matrix, it is derived with to_rot_mat() on demand
+*/
+
+class Attitude {
+
+public:
+
+    double w; // scalar part
+    double x; // vector part, x component
+    double y; // vector part, y component
+    double z; // vector part, z component
+
+    Attitude(); // constructor (identity attitude, local frame equals global frame)
+
+    Attitude(double w, double x, double y, double z); // constructor (quaternion components)
+
+    static Attitude from_axis_angle(double axis_x, double axis_y, double axis_z, double angle); // attitude change that rotates coordinates by angle about a unit axis (same as compute_axis_angle_matrix)
+
+    static Attitude from_maneuver(Maneuver_Axis axis, double angle); // attitude change of a single roll, pitch, or yaw maneuver (same as compute_rotation_matrix)
+
+    Attitude operator*(const Attitude &other) const; // compose attitudes (other is applied first)
+
+    Attitude inverse() const; // inverse attitude (conjugate, goes from local to global coordinates)
+
+    void normalize(); // rescale to unit length (removes floating-point drift after many compositions)
+
+    void rotate(double &x, double &y, double &z) const; // rotate global coordinates into local coordinates
+
+    void inverse_rotate(double &x, double &y, double &z) const; // rotate local coordinates back into global coordinates
+
+    void to_rot_mat(double rot_mat[3][3]) const; // equivalent rotation matrix (global to local cartesian coords)
+
+};
+
+#endif
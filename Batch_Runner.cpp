@@ -0,0 +1,736 @@
+#include "Batch_Runner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include "Target_File_Reader.hpp"
+#include "Sequence_Optimizer.hpp"
+#include "Constellation.hpp"
+#include "Telemetry_Reader.hpp"
+#include "Command_Queue.hpp"
+#include "Console_Manager.hpp"
+#include "Snapshot_Formatter.hpp"
+#include "Fov_Query.hpp"
+#include "Parameter_Sweep.hpp"
+#include "Command_Server.hpp"
+#include "Satellite_Scheduler.hpp"
+
+/* Results file format (CSV, one header row then one row per valid target, angles in degrees, times in seconds):
+    index, target x/y/z, planner mode, roll angle, pitch or yaw maneuver and angle, roll and pitch/yaw accel/coast/decel times,
+    slew time, two step slew time and total time saved by the planner mode versus the original sequential roll, pitch/yaw, zoom, zoom time, peak reaction wheel saturation per axis [%], final pointing error
+    (an eigen-axis slew has no roll, its single rotation is reported in the pitch/yaw columns with maneuver "Eigen")
+
+   Field of view passes file format (CSV, one header row then one row per catalog target pass, times in seconds from the start of the slew):
+    slew index, slew target x/y/z, catalog target index and name (quoted), entry time, exit time, time in view
+
+   Sweep results file format (CSV, one header row then one row per satellite config, angles in degrees, times in seconds):
+    config index, mass, size, inertia (as used), max torque, max angular momentum, zoom rate, reorientations, mean/median/95th percentile/max slew time,
+    total campaign time, mean and max peak reaction wheel saturation per axis [%], max final pointing error, wall clock time of the campaign
+    (a config that can't be simulated gets a row with just its properties and the problem in place of the results)
+*/
+
+// stream every target in a target file through Ideal_Cube_Sat::reorient and write one CSV results row per target (and every frame to the recorder, if any), returns the process exit code
+int run_batch(const char *target_path, const char *results_path, Clock_Mode clock_mode, double time_scale, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder) {
+
+    // map the target file
+    Target_File_Reader reader(target_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: Unable to open target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+
+    // open the results file with a large write buffer (rows are small, so let the C library batch them into big writes)
+    std::FILE *results = std::fopen(results_path, "w");
+    if (results == nullptr) {
+        std::cerr << "ERROR: Unable to open results file '" << results_path << "'" << std::endl;
+        return 1;
+    }
+    std::setvbuf(results, nullptr, _IOFBF, 1 << 20);
+
+    // write the header row
+    std::fputs("index,x,y,z,planner,roll_deg,tilt_maneuver,tilt_deg,"
+               "roll_t_accel,roll_t_coast,roll_t_decel,tilt_t_accel,tilt_t_coast,tilt_t_decel,slew_t,two_step_slew_t,time_saved,zoom_t,"
+               "peak_sat_roll,peak_sat_pitch,peak_sat_yaw,pointing_error_deg\n", results);
+
+    // initialize a headless satellite (the console would only slow a batch run down)
+    Ideal_Cube_Sat sat(clock_mode, time_scale, true, config);
+    sat.set_planner_mode(planner_mode);
+    sat.set_recorder(recorder);
+
+    // conversion factor for reporting angles
+    const double rad_to_deg = 180.0 / M_PI;
+
+    // loop variables
+    double x, y, z;            // current target point
+    size_t index         = 0;  // number of targets simulated so far
+    double simulated_time = 0; // s (total maneuver and zoom time simulated)
+    double saved_time     = 0; // s (total time saved versus the original sequential roll, pitch/yaw, zoom)
+    char   row[512];           // formatted results row
+    auto   t_wall_start  = std::chrono::steady_clock::now();
+
+    // stream the targets through the simulator one at a time
+    while (reader.next(x, y, z)) {
+
+        // set the target and execute the attitude maneuvers
+        sat.set_target(x, y, z);
+        sat.reorient();
+
+        // format the results row (eigen-axis slews are reported as a single "Eigen" maneuver with no roll)
+        const Reorient_Metrics   &m = sat.last_metrics;
+        const Reorientation_Plan &p = m.plan;
+        bool eigen = (p.mode == Planner_Mode::Eigen_Axis);
+        int length = std::snprintf(row, sizeof(row),
+                                   "%zu,%.9g,%.9g,%.9g,%s,%.6f,%s,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.4f,%.4f,%.4f,%.3e\n",
+                                   index, x, y, z, planner_mode_name(p.mode),
+                                   eigen ? 0.0 : p.roll_angle * rad_to_deg,
+                                   eigen ? "Eigen" : axis_name(p.tilt_axis),
+                                   eigen ? p.eigen_angle * rad_to_deg : p.tilt_sign * p.target_theta * rad_to_deg,
+                                   eigen ? 0.0 : p.roll_t_accel, eigen ? 0.0 : p.roll_t_coast, eigen ? 0.0 : p.roll_t_decel,
+                                   eigen ? p.eigen_t_accel : p.tilt_t_accel, eigen ? p.eigen_t_coast : p.tilt_t_coast, eigen ? p.eigen_t_decel : p.tilt_t_decel,
+                                   p.slew_time, p.two_step_slew_time, p.time_saved, p.zoom_time,
+                                   m.peak_saturation_roll, m.peak_saturation_pitch, m.peak_saturation_yaw,
+                                   m.pointing_error * rad_to_deg);
+        std::fwrite(row, 1, static_cast<size_t>(length), results);
+
+        // update totals
+        simulated_time += p.total_time;
+        saved_time     += p.time_saved;
+        index++;
+    }
+
+    // make sure everything made it to disk
+    bool write_failed = (std::fclose(results) != 0);
+    if (write_failed) {
+        std::cerr << "ERROR: Failed writing results file '" << results_path << "'" << std::endl;
+    }
+
+    // report a summary of the run
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+    std::cout << "Simulated " << index << " reorientations (" << simulated_time << " s of maneuvers) in " << t_wall << " s, "
+              << reader.get_invalid_lines() << " invalid target lines skipped" << std::endl;
+    std::cout << "Planner mode '" << planner_mode_name(planner_mode) << "' saved " << saved_time << " s versus the sequential roll, pitch/yaw, zoom" << std::endl;
+
+    return write_failed ? 1 : 0;
+}
+
+// optimize the visiting order of every target in a target file, report the time saved versus file order, then execute the plan with Ideal_Cube_Sat::reorient, returns the process exit code
+int run_sequence(const char *target_path, Clock_Mode clock_mode, double time_scale, bool headless, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder) {
+
+    // map the target file
+    Target_File_Reader reader(target_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: Unable to open target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+
+    // load the whole queue (the optimizer needs every target up front)
+    std::vector<Target_Point> targets;
+    Target_Point target;
+    while (reader.next(target.x, target.y, target.z)) {
+        targets.push_back(target);
+    }
+
+    // initialize the satellite object
+    Ideal_Cube_Sat sat(clock_mode, time_scale, headless, config);
+    sat.set_planner_mode(planner_mode);
+    sat.set_recorder(recorder);
+
+    // optimize the visiting order on every available core
+    auto t_wall_start = std::chrono::steady_clock::now();
+    Sequence_Result result;
+    Sequence_Optimizer optimizer(sat, targets, std::thread::hardware_concurrency());
+    optimizer.optimize(result);
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+
+    // report the time savings versus visiting the targets in file order
+    double saved = result.fifo_time - result.optimized_time;
+    std::cout << "Sequenced " << targets.size() << " targets in " << t_wall << " s (" << result.passes << " improvement passes)" << std::endl;
+    std::cout << "    File order:        " << result.fifo_time      << " s" << std::endl;
+    std::cout << "    Nearest neighbour: " << result.seed_time      << " s" << std::endl;
+    std::cout << "    Optimized:         " << result.optimized_time << " s (saves " << saved << " s, " << (result.fifo_time > 0.0 ? 100.0 * saved / result.fifo_time : 0.0) << "%)" << std::endl;
+
+    // execute the plan in order
+    for (size_t index : result.order) {
+
+        // set the target and execute the attitude maneuvers
+        const Target_Point &p = targets[index];
+        sat.set_target(p.x, p.y, p.z);
+        sat.reorient();
+
+        // report progress
+        if (headless) {
+            std::cout << index << ": " << p.x << " " << p.y << " " << p.z << " -> " << sat.curr_point.global_x << " " << sat.curr_point.global_y << " " << sat.curr_point.global_z << std::endl;
+        } else {
+            sat.print_info(Status_Message::None);
+        }
+    }
+
+    return 0;
+}
+
+// plan a slew to every target in a target file in order (closed form, no frames simulated) and write every catalog target that passes through the field of view during each slew to a CSV file, returns the process exit code
+int run_fov_passes(const char *target_path, const char *passes_path, const char *catalog_path, double half_angle, Planner_Mode planner_mode, const Satellite_Config &config) {
+
+    // map the target file
+    Target_File_Reader reader(target_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: Unable to open target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+
+    // load and index the catalog
+    auto t_load_start = std::chrono::steady_clock::now();
+    Target_Catalog catalog;
+    if (!catalog.load(catalog_path)) {
+        std::cerr << "ERROR: Unable to open target catalog '" << catalog_path << "'" << std::endl;
+        return 1;
+    }
+    double t_load = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_load_start).count();
+
+    // open the passes file with a large write buffer
+    std::FILE *results = std::fopen(passes_path, "w");
+    if (results == nullptr) {
+        std::cerr << "ERROR: Unable to open passes file '" << passes_path << "'" << std::endl;
+        return 1;
+    }
+    std::setvbuf(results, nullptr, _IOFBF, 1 << 20);
+    std::fputs("slew,x,y,z,catalog_index,name,t_enter,t_exit,t_in_view\n", results);
+
+    // the satellite only supplies its hardware and starting attitude, the slews are planned in closed form one after another
+    Ideal_Cube_Sat sat(Clock_Mode::Stepped, 1.0, true, config);
+    Attitude attitude = sat.get_attitude();
+    double   curr_r   = sat.curr_point.local_r;
+
+    // loop variables
+    Fov_Query query(catalog);
+    std::vector<Fov_Pass> passes;
+    Reorientation_Plan plan;
+    double x, y, z;           // current target point
+    size_t index       = 0;   // number of slews planned so far
+    size_t pass_count  = 0;   // number of passes found so far
+    double query_time  = 0.0; // s (wall clock time spent in the field of view query)
+    char   row[512];          // formatted results row
+
+    while (reader.next(x, y, z)) {
+
+        // plan the slew from where the previous one ended
+        plan_reorientation(attitude, curr_r, x, y, z, sat.reaction_wheel_roll, sat.reaction_wheel_pitch, sat.reaction_wheel_yaw, sat.get_zoom_rate(), plan, planner_mode);
+
+        // find every catalog target that passes through the field of view along the way
+        auto t_query_start = std::chrono::steady_clock::now();
+        query.find_passes(attitude, plan, half_angle, passes);
+        query_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - t_query_start).count();
+
+        // one row per pass (names are quoted, with any quotes doubled)
+        for (const Fov_Pass &pass : passes) {
+            int length = std::snprintf(row, sizeof(row), "%zu,%.9g,%.9g,%.9g,%zu,\"", index, x, y, z, catalog.get_load_index(pass.target));
+            std::fwrite(row, 1, static_cast<size_t>(length), results);
+            for (const char *c = catalog.get_name(pass.target); *c != '\0'; c++) {
+                if (*c == '"') {
+                    std::fputc('"', results);
+                }
+                std::fputc(*c, results);
+            }
+            length = std::snprintf(row, sizeof(row), "\",%.6f,%.6f,%.6f\n", pass.t_enter, pass.t_exit, pass.t_exit - pass.t_enter);
+            std::fwrite(row, 1, static_cast<size_t>(length), results);
+        }
+
+        // the next slew starts where this one ended
+        attitude    = plan.final_attitude;
+        curr_r      = plan.target_r;
+        pass_count += passes.size();
+        index++;
+    }
+
+    // make sure everything made it to disk
+    bool write_failed = (std::fclose(results) != 0);
+    if (write_failed) {
+        std::cerr << "ERROR: Failed writing passes file '" << passes_path << "'" << std::endl;
+    }
+
+    // report a summary of the run
+    std::cout << "Loaded " << catalog.size() << " catalog targets in " << t_load << " s" << std::endl;
+    std::cout << "Found " << pass_count << " field of view passes over " << index << " slews (" << half_angle * 180.0 / M_PI << " deg half angle) in " << query_time << " s ("
+              << (index > 0 ? 1000.0 * query_time / index : 0.0) << " ms per slew), " << reader.get_invalid_lines() << " invalid target lines skipped" << std::endl;
+
+    return write_failed ? 1 : 0;
+}
+
+// run a reorientation campaign over every target in a target file for every satellite config of a sweep file, spread across thread_count threads (zero for one per core),
+// and write one CSV row of slew time and saturation statistics per config, returns the process exit code
+int run_sweep(const char *sweep_path, const char *target_path, const char *results_path, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count) {
+
+    // read the sweep and expand it into configs
+    Parameter_Sweep sweep(config);
+    if (!sweep.load(sweep_path)) {
+        return 1;
+    }
+    std::vector<Satellite_Config> configs;
+    sweep.generate(configs);
+
+    // load the whole campaign (every config visits the same targets in the same order)
+    Target_File_Reader reader(target_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: Unable to open target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+    std::vector<Target_Point> targets;
+    Target_Point target;
+    while (reader.next(target.x, target.y, target.z)) {
+        targets.push_back(target);
+    }
+
+    std::FILE *results = std::fopen(results_path, "w");
+    if (results == nullptr) {
+        std::cerr << "ERROR: Unable to open results file '" << results_path << "'" << std::endl;
+        return 1;
+    }
+    std::setvbuf(results, nullptr, _IOFBF, 1 << 20);
+
+    // run every campaign
+    Work_Stealing_Pool pool(thread_count);
+    std::vector<Sweep_Result> sweep_results;
+    auto t_wall_start = std::chrono::steady_clock::now();
+    Parameter_Sweep::run(configs, targets, planner_mode, pool, sweep_results);
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+
+    // write one row per config
+    const double rad_to_deg = 180.0 / M_PI;
+    std::fputs("config,mass,size,inertia,max_torque,max_angular_momentum,zoom_rate,reorientations,slew_mean,slew_p50,slew_p95,slew_max,total_time,"
+               "sat_mean_roll,sat_mean_pitch,sat_mean_yaw,sat_max_roll,sat_max_pitch,sat_max_yaw,pointing_error_max_deg,wall_time\n", results);
+    char   row[512];
+    double campaign_time = 0.0;                // s (wall clock time of all campaigns added up, what a single thread would have taken)
+    const Sweep_Result *best = nullptr;        // config with the lowest mean slew time
+    size_t failed = 0;                         // configs that couldn't be simulated
+    for (size_t i = 0; i < sweep_results.size(); i++) {
+
+        const Sweep_Result &r = sweep_results[i];
+        const Satellite_Config &c = r.config;
+        int length = std::snprintf(row, sizeof(row), "%zu,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,", i, c.mass, c.size, c.get_inertia(), c.max_torque, c.max_angular_momentum, c.zoom_rate);
+        std::fwrite(row, 1, static_cast<size_t>(length), results);
+
+        if (r.problem != nullptr) {
+            std::fprintf(results, "\"%s\"\n", r.problem);
+            failed++;
+            continue;
+        }
+
+        length = std::snprintf(row, sizeof(row), "%zu,%.6f,%.6f,%.6f,%.6f,%.6f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.3e,%.6f\n",
+                               r.reorientations, r.slew_mean, r.slew_p50, r.slew_p95, r.slew_max, r.total_time,
+                               r.saturation_mean[0], r.saturation_mean[1], r.saturation_mean[2], r.saturation_max[0], r.saturation_max[1], r.saturation_max[2],
+                               r.pointing_error_max * rad_to_deg, r.wall_time);
+        std::fwrite(row, 1, static_cast<size_t>(length), results);
+
+        campaign_time += r.wall_time;
+        if (best == nullptr || r.slew_mean < best->slew_mean) {
+            best = &r;
+        }
+    }
+
+    // make sure everything made it to disk
+    bool write_failed = (std::fclose(results) != 0);
+    if (write_failed) {
+        std::cerr << "ERROR: Failed writing results file '" << results_path << "'" << std::endl;
+    }
+
+    // report a summary of the sweep
+    std::cout << "Swept " << configs.size() << " satellite configs x " << targets.size() << " targets (planner '" << planner_mode_name(planner_mode) << "') in " << t_wall << " s on "
+              << pool.get_thread_count() << " threads (" << campaign_time << " s of campaigns, " << pool.get_steals() << " steals), "
+              << failed << " invalid configs skipped" << std::endl;
+    if (best != nullptr) {
+        std::cout << "Lowest mean slew time: " << best->slew_mean << " s (p95 " << best->slew_p95 << " s) with mass " << best->config.mass << " kg, size " << best->config.size
+                  << " m, inertia " << best->config.get_inertia() << " kg*m^2, max torque " << best->config.max_torque << " N*m, max momentum " << best->config.max_angular_momentum
+                  << " N*m*s, zoom rate " << best->config.zoom_rate << std::endl;
+    }
+
+    return write_failed ? 1 : 0;
+}
+
+// reorient one satellite of a fleet to every target in order, starting at target first and wrapping around (one physics frame per resume()), adds up the slew times
+static Maneuver_Task fly_campaign(Ideal_Cube_Sat &sat, const std::vector<Target_Point> &targets, size_t first, double &slew_time, size_t &reorientations) {
+
+    for (size_t n = 0; n < targets.size(); n++) {
+
+        const Target_Point &target = targets[(first + n) % targets.size()];
+        if (!sat.set_target(target.x, target.y, target.z)) {
+            continue;
+        }
+
+        // hand the thread back after every frame of the reorientation
+        Maneuver_Task reorientation = sat.reorient_task();
+        while (reorientation.resume()) {
+            co_yield reorientation.status();
+        }
+
+        slew_time += sat.last_metrics.plan.slew_time;
+        reorientations++;
+    }
+}
+
+// fly count headless satellites (step clock) through a reorientation campaign over every target in a target file, each satellite starting at a different target,
+// interleaved one frame at a time on thread_count threads (zero for one per core) by a Satellite_Scheduler, report satellite-frames per second, returns the process exit code
+int run_fleet(size_t count, const char *target_path, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count) {
+
+    const char *problem = config.check();
+    if (problem != nullptr) {
+        std::cerr << "ERROR: Invalid satellite config (" << problem << ")" << std::endl;
+        return 1;
+    }
+
+    // load the whole campaign (every satellite visits the same targets, starting at a different one)
+    Target_File_Reader reader(target_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: Unable to open target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+    std::vector<Target_Point> targets;
+    Target_Point target;
+    while (reader.next(target.x, target.y, target.z)) {
+        targets.push_back(target);
+    }
+    if (targets.empty()) {
+        std::cerr << "ERROR: No valid targets in target file '" << target_path << "'" << std::endl;
+        return 1;
+    }
+
+    // create the fleet (satellites never move in memory, their tasks point at them)
+    std::vector<std::unique_ptr<Ideal_Cube_Sat>> fleet;
+    std::vector<double> slew_times(count, 0.0);
+    std::vector<size_t> reorientations(count, 0);
+    fleet.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        fleet.emplace_back(new Ideal_Cube_Sat(Clock_Mode::Stepped, 1.0, true, config));
+        fleet.back()->set_planner_mode(planner_mode);
+    }
+
+    // one campaign task per satellite, all interleaved on the scheduler's threads
+    Satellite_Scheduler scheduler(thread_count);
+    for (size_t i = 0; i < count; i++) {
+        scheduler.add(fly_campaign(*fleet[i], targets, i % targets.size(), slew_times[i], reorientations[i]));
+    }
+    auto t_wall_start = std::chrono::steady_clock::now();
+    scheduler.run();
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+
+    // report a summary of the fleet
+    double slew_total = 0.0;
+    size_t reorientation_total = 0;
+    for (size_t i = 0; i < count; i++) {
+        slew_total += slew_times[i];
+        reorientation_total += reorientations[i];
+    }
+    double frames = static_cast<double>(scheduler.get_frames());
+    std::cout << "Fleet of " << count << " satellites x " << targets.size() << " targets (planner '" << planner_mode_name(planner_mode) << "'): "
+              << reorientation_total << " reorientations, " << scheduler.get_frames() << " satellite-frames in " << scheduler.get_steps() << " steps" << std::endl;
+    std::cout << "    " << t_wall << " s on " << scheduler.get_thread_count() << " threads, " << frames / t_wall << " satellite-frames/s ("
+              << 1e9 * t_wall / frames << " ns per satellite-frame)" << std::endl;
+    if (reorientation_total > 0) {
+        std::cout << "    Mean slew time: " << slew_total / static_cast<double>(reorientation_total) << " s" << std::endl;
+    }
+
+    return 0;
+}
+
+// stream random imaging targets (rate per hour, for a number of hours) to a fleet of satellites through a Task_Allocator, allocating once a minute with
+// scoring on thread_count threads (zero for one per core), report imaged and expired targets, waiting times, and allocation cost, returns the process exit code
+int run_allocation(size_t satellite_count, double rate, double hours, Allocation_Mode allocation_mode, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count) {
+
+    const char *problem = config.check();
+    if (problem != nullptr) {
+        std::cerr << "ERROR: Invalid satellite config (" << problem << ")" << std::endl;
+        return 1;
+    }
+
+    // the allocator runs once per period, like a ground station uplink cycle
+    const double period   = 60.0;          // s
+    const double duration = hours * 3600.0; // s (length of the target stream)
+
+    // same target stream for every run (Poisson arrivals, random direction, distance between 1 and 5)
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::exponential_distribution<double> gap(rate / 3600.0);
+    double arrival = gap(rng);
+
+    Task_Allocator allocator(satellite_count, config, allocation_mode, planner_mode, thread_count);
+    double now = 0.0;
+    while (now < duration || allocator.get_backlog() > 0) {
+
+        now += period;
+
+        // everything that arrived since the last call
+        while (arrival <= now && arrival < duration) {
+            double cos_theta = 2.0 * uniform(rng) - 1.0;
+            double sin_theta = sqrt(1.0 - cos_theta * cos_theta);
+            double phi       = 2.0 * M_PI * uniform(rng);
+            double r         = 1.0 + 4.0 * uniform(rng);
+            allocator.submit(r * sin_theta * cos(phi), r * sin_theta * sin(phi), r * cos_theta, arrival);
+            arrival += gap(rng);
+        }
+
+        allocator.allocate(now);
+    }
+
+    // the stream is over, whatever is queued gets imaged
+    allocator.finish();
+
+    // report a summary of the stream
+    const Allocation_Stats &stats = allocator.stats;
+    double imaged = static_cast<double>(std::max<size_t>(stats.imaged, 1));
+    std::cout << "Allocated " << stats.submitted << " targets (" << rate << " per hour for " << hours << " h) to " << satellite_count << " satellites (allocator '"
+              << allocation_mode_name(allocation_mode) << "', planner '" << planner_mode_name(planner_mode) << "')" << std::endl;
+    std::cout << "    Imaged " << stats.imaged << ", expired " << stats.expired << ", reassigned " << stats.reassigned << " times, mean wait " << stats.wait_total / imaged
+              << " s (max " << stats.wait_max << " s), fleet busy " << 100.0 * stats.busy_total / (static_cast<double>(satellite_count) * std::max(stats.finish_time, 1e-9)) << "%" << std::endl;
+    std::cout << "    allocate(): " << stats.allocate_time << " s over " << stats.calls << " calls on " << allocator.get_thread_count() << " threads (mean "
+              << 1e3 * stats.allocate_time / static_cast<double>(std::max<uint64_t>(stats.calls, 1)) << " ms, max " << 1e3 * stats.allocate_max << " ms), "
+              << stats.plans << " pairs scored in " << stats.rounds << " rounds, " << now / std::max(stats.allocate_time, 1e-9) << "x faster than the stream" << std::endl;
+
+    return 0;
+}
+
+// step a constellation of satellites through random retargets for a stretch of simulated time, report the cost per satellite-step of the AVX2 and reference kernels, returns the process exit code
+int run_constellation(size_t count, double duration, const Satellite_Config &config) {
+
+    // frames are stepped at the same rate as the console refresh
+    const double FPS    = 60.0;
+    const double dt     = 1.0 / FPS;
+    const size_t frames = static_cast<size_t>(std::ceil(duration * FPS));
+
+    // fly the whole constellation with one kernel, every satellite gets a new random target as soon as it settles
+    auto simulate = [&](Constellation &fleet, double &step_time, size_t &retargets) {
+
+        // same target sequence for every run
+        std::mt19937_64 rng(12345);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        step_time = 0.0;
+        retargets = 0;
+        for (size_t frame = 0; frame < frames; frame++) {
+
+            // step every satellite (the only part that is timed)
+            auto t_start = std::chrono::steady_clock::now();
+            fleet.step(dt);
+            step_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+            // retarget the settled satellites (random direction, distance between 1 and 5)
+            for (size_t i = 0; i < fleet.count; i++) {
+                if (fleet.is_settled(i)) {
+                    double cos_theta = 2.0 * uniform(rng) - 1.0;
+                    double sin_theta = sqrt(1.0 - cos_theta * cos_theta);
+                    double phi       = 2.0 * M_PI * uniform(rng);
+                    double r         = 1.0 + 4.0 * uniform(rng);
+                    fleet.set_target(i, r * sin_theta * cos(phi), r * sin_theta * sin(phi), r * cos_theta);
+                    retargets++;
+                }
+            }
+        }
+    };
+
+    // reference kernel
+    Constellation reference(count, config);
+    reference.set_simd(false);
+    double reference_time;
+    size_t reference_retargets;
+    simulate(reference, reference_time, reference_retargets);
+
+    double steps = static_cast<double>(count) * static_cast<double>(frames);
+    std::cout << "Constellation of " << count << " satellites, " << frames << " frames (" << frames / FPS << " s), " << reference_retargets << " retargets" << std::endl;
+    std::cout << "    Reference kernel: " << 1e9 * reference_time / steps << " ns per satellite-step" << std::endl;
+
+    if (!Constellation::simd_available()) {
+        std::cout << "    AVX2 kernel:      not supported by this CPU" << std::endl;
+        return 0;
+    }
+
+    // AVX2 kernel
+    Constellation fleet(count, config);
+    fleet.set_simd(true);
+    double simd_time;
+    size_t simd_retargets;
+    simulate(fleet, simd_time, simd_retargets);
+    std::cout << "    AVX2 kernel:      " << 1e9 * simd_time / steps << " ns per satellite-step (" << reference_time / simd_time << "x)" << std::endl;
+
+    // check both kernels agree on the same input (re-evaluate the final state of the AVX2 run with each kernel)
+    Constellation check = fleet;
+    check.set_simd(false);
+    check.step(0.0);
+    fleet.step(0.0);
+    double max_attitude = 0.0;
+    double max_pointing = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        max_attitude = std::max({max_attitude, std::abs(check.q_w[i] - fleet.q_w[i]), std::abs(check.q_x[i] - fleet.q_x[i]), std::abs(check.q_y[i] - fleet.q_y[i]), std::abs(check.q_z[i] - fleet.q_z[i])});
+        max_pointing = std::max(max_pointing, std::abs(check.target_theta[i] - fleet.target_theta[i]));
+    }
+    std::cout << "    Kernel agreement: max attitude difference " << max_attitude << ", max pointing error difference " << max_pointing << " rad" << std::endl;
+
+    return 0;
+}
+
+// serve Server_Protocol.hpp plan, execute, and state stream requests to local clients on a Unix domain socket with one headless satellite (Linux only), until SIGINT or SIGTERM, returns the process exit code
+int run_server(const char *socket_path, Clock_Mode clock_mode, double time_scale, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder) {
+
+    // initialize a headless satellite (every client commands the same one)
+    Ideal_Cube_Sat sat(clock_mode, time_scale, true, config);
+    sat.set_planner_mode(planner_mode);
+    sat.set_recorder(recorder);
+
+    // bind the socket
+    Command_Server server(sat, planner_mode);
+    if (!server.start(socket_path)) {
+        return 1;
+    }
+    sat.set_server(&server);
+
+    // handle clients until interrupted
+    std::cout << "Serving on '" << socket_path << "' (Ctrl+C to stop)" << std::endl;
+    auto t_wall_start = std::chrono::steady_clock::now();
+    server.run();
+    sat.set_server(nullptr);
+
+    // report a summary of the session
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+    std::cout << "Handled " << server.get_requests() << " requests in " << t_wall << " s (" << server.get_targets_planned() << " targets planned, "
+              << server.get_targets_executed() << " executed), streamed " << server.get_frames_streamed() << " state frames, "
+              << server.get_frames_dropped() << " dropped for slow clients" << std::endl;
+
+    return 0;
+}
+
+// convert a telemetry file to CSV (one row per recorded frame, oldest first), returns the process exit code
+int run_telemetry_export(const char *telemetry_path, const char *csv_path) {
+
+    // map and validate the telemetry file
+    Telemetry_Reader reader(telemetry_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: '" << telemetry_path << "' is not a valid telemetry file" << std::endl;
+        return 1;
+    }
+
+    // open the CSV file with a large write buffer
+    std::FILE *csv = std::fopen(csv_path, "w");
+    if (csv == nullptr) {
+        std::cerr << "ERROR: Unable to open CSV file '" << csv_path << "'" << std::endl;
+        return 1;
+    }
+    std::setvbuf(csv, nullptr, _IOFBF, 1 << 20);
+
+    // write the header row (angles and rates in degrees)
+    Snapshot_Formatter formatter;
+    formatter.format_csv_header();
+    std::fwrite(formatter.data(), 1, formatter.size(), csv);
+
+    // one row per record, oldest first (formatted from the same snapshot the dashboard shows)
+    Satellite_Snapshot snapshot;
+    for (uint64_t i = 0; i < reader.size(); i++) {
+        Telemetry_Reader::to_snapshot(reader.record(i), snapshot);
+        formatter.format_csv_row(snapshot);
+        std::fwrite(formatter.data(), 1, formatter.size(), csv);
+    }
+
+    // make sure everything made it to disk
+    bool write_failed = (std::fclose(csv) != 0);
+    if (write_failed) {
+        std::cerr << "ERROR: Failed writing CSV file '" << csv_path << "'" << std::endl;
+    }
+
+    std::cout << "Exported " << reader.size() << " telemetry records (" << reader.get_dropped() << " older records were overwritten by the ring)" << std::endl;
+
+    return write_failed ? 1 : 0;
+}
+
+// replay a telemetry file on the dashboard, with play, pause, seek, and time warp commands read from stdin, returns the process exit code
+int run_replay(const char *telemetry_path, double time_scale) {
+
+    // map and validate the telemetry file
+    Telemetry_Reader reader(telemetry_path);
+    if (!reader.is_open()) {
+        std::cerr << "ERROR: '" << telemetry_path << "' is not a valid telemetry file" << std::endl;
+        return 1;
+    }
+    if (reader.size() == 0) {
+        std::cerr << "ERROR: Telemetry file '" << telemetry_path << "' has no records" << std::endl;
+        return 1;
+    }
+
+    // the dashboard redraws at 60 FPS in realtime, whatever the frame period of the recording
+    const double FPS = 60.0;
+    Sim_Clock clock(Clock_Mode::Wall, 1.0, FPS);
+    Console_Manager console_man;
+
+    // replay state (time is recorded session time)
+    const double start_time = reader.record(0).sim_time;
+    const double end_time   = reader.record(reader.size() - 1).sim_time;
+    double   replay_time = start_time;
+    double   warp        = time_scale;
+    bool     playing     = true;
+    uint64_t index       = 0;
+
+    // commands come from their own thread, so the dashboard keeps playing while the user types
+    Command_Queue commands;
+    std::string command;
+    Satellite_Snapshot snapshot;
+    bool quit = false;
+
+    console_man.clear_buffer();
+    clock.start();
+    while (!quit) {
+
+        // apply every command typed since the last frame
+        while (commands.poll(command)) {
+
+            if (command == "quit") {
+                quit = true;
+            } else if (command == "play") {
+                if (replay_time >= end_time) {
+                    replay_time = start_time;
+                    index = 0;
+                }
+                playing = true;
+            } else if (command == "pause") {
+                playing = false;
+            } else if (command.compare(0, 5, "seek ") == 0) {
+
+                // seconds from the start of the replay, or relative to the current time with a leading + or -
+                const char *argument = command.c_str() + 5;
+                double time = std::atof(argument);
+                time += (argument[0] == '+' || argument[0] == '-') ? replay_time : start_time;
+                replay_time = std::min(std::max(time, start_time), end_time);
+
+                // binary search of the ring (O(log n), no decoding from the start)
+                index = reader.find_time(replay_time);
+
+            } else if (command.compare(0, 5, "warp ") == 0) {
+                double factor = std::atof(command.c_str() + 5);
+                if (factor > 0.0) {
+                    warp = factor;
+                }
+            }
+
+            // the command echo left text below the dashboard
+            console_man.clear_buffer();
+        }
+
+        // advance replay time, then step forward to the record on screen at that time (playback only moves forward, a few records per frame)
+        if (playing) {
+            replay_time += warp / FPS;
+            if (replay_time >= end_time) {
+                replay_time = end_time;
+                playing = false;
+            }
+            while (index + 1 < reader.size() && reader.record(index + 1).sim_time <= replay_time) {
+                index++;
+            }
+        }
+
+        // draw the record with the replay status in front of the recorded message
+        Telemetry_Reader::to_snapshot(reader.record(index), snapshot);
+        std::snprintf(snapshot.message, sizeof(snapshot.message), "[REPLAY %.2f / %.2f s x%g %s] %s",
+                      replay_time - start_time, end_time - start_time, warp, playing ? "PLAYING" : "PAUSED", status_text(snapshot.status));
+        console_man.update(snapshot);
+
+        clock.end_frame();
+    }
+
+    return 0;
+}
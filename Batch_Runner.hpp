@@ -0,0 +1,41 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include "Ideal_Cube_Sat.hpp"
+#include "Telemetry_Recorder.hpp"
+#include "Task_Allocator.hpp"
+
+// stream every target in a target file through Ideal_Cube_Sat::reorient and write one CSV results row per target (and every frame to the recorder, if any), returns the process exit code
+int run_batch(const char *target_path, const char *results_path, Clock_Mode clock_mode, double time_scale, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder);
+
+// optimize the visiting order of every target in a target file, report the time saved versus file order, then execute the plan with Ideal_Cube_Sat::reorient, returns the process exit code
+int run_sequence(const char *target_path, Clock_Mode clock_mode, double time_scale, bool headless, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder);
+
+// plan a slew to every target in a target file in order (closed form, no frames simulated) and write every catalog target that passes through the field of view during each slew to a CSV file, returns the process exit code
+int run_fov_passes(const char *target_path, const char *passes_path, const char *catalog_path, double half_angle, Planner_Mode planner_mode, const Satellite_Config &config);
+
+// step a constellation of satellites through random retargets for a stretch of simulated time, report the cost per satellite-step of the AVX2 and reference kernels, returns the process exit code
+int run_constellation(size_t count, double duration, const Satellite_Config &config);
+
+// run a reorientation campaign over every target in a target file for every satellite config of a sweep file, spread across thread_count threads (zero for one per core),
+// and write one CSV row of slew time and saturation statistics per config, returns the process exit code
+int run_sweep(const char *sweep_path, const char *target_path, const char *results_path, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count);
+
+// fly count headless satellites (step clock) through a reorientation campaign over every target in a target file, each satellite starting at a different target,
+// interleaved one frame at a time on thread_count threads (zero for one per core) by a Satellite_Scheduler, report satellite-frames per second, returns the process exit code
+int run_fleet(size_t count, const char *target_path, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count);
+
+// stream random imaging targets (rate per hour, for a number of hours) to a fleet of satellites through a Task_Allocator, allocating once a minute with
+// scoring on thread_count threads (zero for one per core), report imaged and expired targets, waiting times, and allocation cost, returns the process exit code
+int run_allocation(size_t satellite_count, double rate, double hours, Allocation_Mode allocation_mode, Planner_Mode planner_mode, const Satellite_Config &config, unsigned thread_count);
+
+// serve Server_Protocol.hpp plan, execute, and state stream requests to local clients on a Unix domain socket with one headless satellite (Linux only), until SIGINT or SIGTERM, returns the process exit code
+int run_server(const char *socket_path, Clock_Mode clock_mode, double time_scale, Planner_Mode planner_mode, const Satellite_Config &config, Telemetry_Recorder *recorder);
+
+// convert a telemetry file to CSV (one row per recorded frame, oldest first), returns the process exit code
+int run_telemetry_export(const char *telemetry_path, const char *csv_path);
+
+// replay a telemetry file on the dashboard, with play, pause, seek, and time warp commands read from stdin, returns the process exit code
+int run_replay(const char *telemetry_path, double time_scale);
+
+#endif
@@ -0,0 +1,484 @@
+#include "Benchmark_Suite.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "Allocation_Counter.hpp"
+#include "Helper_Functions.hpp"
+#include "Location.hpp"
+#include "Reaction_Wheel.hpp"
+#include "Ideal_Cube_Sat.hpp"
+#include "Snapshot_Formatter.hpp"
+#include "Target_Catalog.hpp"
+#include "Fov_Query.hpp"
+
+/* Results file format (CSV, one header row then one row per benchmark):
+    benchmark, input distribution, ns per operation, heap allocations per operation, operations timed
+*/
+
+// a result counts as a regression if it is this much slower than the baseline (timing noise between runs is a few percent)
+static const double regression_ratio = 1.25;
+
+// every kernel result is added here, so the compiler can't drop the work being timed
+static volatile double benchmark_sink = 0.0;
+
+// one benchmark result
+struct Benchmark_Result {
+    std::string name;         // kernel being timed
+    std::string distribution; // input distribution
+    double ns_per_op;         // ns (best round)
+    double allocs_per_op;     // heap allocations per operation
+    unsigned long long ops;   // operations timed over all rounds
+};
+
+// time a kernel over a set of inputs (kernel(i) runs operation i and returns a value that depends on its result)
+template <typename Kernel>
+static Benchmark_Result measure(const char *name, const char *distribution, size_t inputs, double min_time, Kernel kernel) {
+
+    const int rounds = 5;
+    double sink = 0.0;
+
+    // warm up caches and branch predictors with one pass
+    for (size_t i = 0; i < inputs; i++) {
+        sink += kernel(i);
+    }
+
+    Benchmark_Result result;
+    result.name          = name;
+    result.distribution  = distribution;
+    result.ns_per_op     = 0.0;
+    result.allocs_per_op = 0.0;
+    result.ops           = 0;
+
+    for (int round = 0; round < rounds; round++) {
+
+        // repeat whole passes over the inputs until the round is long enough to time
+        unsigned long long passes = 0;
+        uint64_t allocs_start = allocation_count();
+        auto t_start = std::chrono::steady_clock::now();
+        double t_round = 0.0;
+        do {
+            for (size_t i = 0; i < inputs; i++) {
+                sink += kernel(i);
+            }
+            passes++;
+            t_round = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+        } while (t_round < min_time / rounds);
+        uint64_t allocs = allocation_count() - allocs_start;
+
+        // keep the fastest round (the others were disturbed by something else)
+        unsigned long long ops = passes * inputs;
+        double ns_per_op = t_round * 1e9 / static_cast<double>(ops);
+        if (round == 0 || ns_per_op < result.ns_per_op) {
+            result.ns_per_op = ns_per_op;
+        }
+        result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(ops);
+        result.ops += ops;
+    }
+
+    benchmark_sink = benchmark_sink + sink;
+
+    // report as it goes (the whole suite takes a while)
+    std::printf("%-28s %-14s %14.1f %10.3f\n", result.name.c_str(), result.distribution.c_str(), result.ns_per_op, result.allocs_per_op);
+    std::fflush(stdout);
+
+    return result;
+}
+
+// run every benchmark, write the results to a CSV file and compare them with a baseline results file (if any), returns the process exit code (1 on a regression)
+int run_benchmarks(const char *results_path, const char *baseline_path) {
+
+    // same inputs every run
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // inputs per distribution (small enough to stay in cache, the math is being timed, not memory)
+    const size_t inputs   = 4096;
+    const double min_time = 0.25; // s (per benchmark, over all rounds)
+
+    const double deg_to_rad = M_PI / 180.0;
+
+    std::vector<Benchmark_Result> results;
+
+    std::printf("%-28s %-14s %14s %10s\n", "benchmark", "distribution", "ns/op", "allocs/op");
+
+    // angle distributions: small slews (|angle| <= 5 deg), any slew (|angle| <= 180 deg), and almost no slew (|angle| <= 1e-6 rad)
+    struct Angle_Distribution { const char *name; double max_angle; };
+    const Angle_Distribution angle_distributions[] = {
+        {"small",     5.0 * deg_to_rad},
+        {"full",      M_PI},
+        {"near-zero", 1e-6}
+    };
+
+    // compute_rotation_matrix (random maneuver axis)
+    for (const Angle_Distribution &d : angle_distributions) {
+        std::vector<double> angles(inputs);
+        std::vector<Maneuver_Axis> axes(inputs);
+        for (size_t i = 0; i < inputs; i++) {
+            angles[i] = d.max_angle * (2.0 * uniform(rng) - 1.0);
+            axes[i]   = static_cast<Maneuver_Axis>(rng() % 3);
+        }
+        double rot_mat[3][3];
+        results.push_back(measure("compute_rotation_matrix", d.name, inputs, min_time, [&](size_t i) {
+            compute_rotation_matrix(rot_mat, angles[i], axes[i]);
+            return rot_mat[0][1] + rot_mat[1][2] + rot_mat[2][0];
+        }));
+    }
+
+    // random rotation matrices (roll then pitch or yaw, like a two-step maneuver)
+    std::vector<double> matrices(inputs * 9);
+    for (size_t i = 0; i < inputs; i++) {
+        double roll_mat[3][3];
+        double tilt_mat[3][3];
+        compute_rotation_matrix(roll_mat, M_PI * (2.0 * uniform(rng) - 1.0), Maneuver_Axis::Roll);
+        compute_rotation_matrix(tilt_mat, M_PI * (2.0 * uniform(rng) - 1.0), (rng() % 2) ? Maneuver_Axis::Pitch : Maneuver_Axis::Yaw);
+        multiply_rot_mats(tilt_mat, roll_mat, reinterpret_cast<double (*)[3]>(&matrices[i * 9]));
+    }
+    auto matrix = [&](size_t i) { return reinterpret_cast<const double (*)[3]>(&matrices[(i % inputs) * 9]); };
+
+    // multiply_rot_mats (the cost doesn't depend on the values)
+    {
+        double rot_mat[3][3];
+        results.push_back(measure("multiply_rot_mats", "random", inputs, min_time, [&](size_t i) {
+            multiply_rot_mats(matrix(i), matrix(i + 1), rot_mat);
+            return rot_mat[0][0] + rot_mat[1][1] + rot_mat[2][2];
+        }));
+    }
+
+    // point distributions: uniform directions (distance 1 to 100), within 1e-6 rad of the poles (theta near 0 or pi), and distances from 1e-3 to 1e6
+    struct Point_Distribution { const char *name; int kind; };
+    const Point_Distribution point_distributions[] = {
+        {"sphere",    0},
+        {"near-pole", 1},
+        {"wide-range", 2}
+    };
+    for (const Point_Distribution &d : point_distributions) {
+
+        std::vector<double> points(inputs * 3);
+        for (size_t i = 0; i < inputs; i++) {
+            double cos_theta = 2.0 * uniform(rng) - 1.0;
+            double phi       = 2.0 * M_PI * uniform(rng);
+            double r         = 1.0 + 99.0 * uniform(rng);
+            if (d.kind == 1) {
+                cos_theta = ((rng() % 2) ? 1.0 : -1.0) * cos(1e-6 * uniform(rng));
+            } else if (d.kind == 2) {
+                r = pow(10.0, -3.0 + 9.0 * uniform(rng));
+            }
+            double sin_theta = sqrt(1.0 - cos_theta * cos_theta);
+            points[i * 3 + 0] = r * sin_theta * cos(phi);
+            points[i * 3 + 1] = r * sin_theta * sin(phi);
+            points[i * 3 + 2] = r * cos_theta;
+        }
+
+        // apply_rotation
+        results.push_back(measure("apply_rotation", d.name, inputs, min_time, [&](size_t i) {
+            double x = points[i * 3 + 0];
+            double y = points[i * 3 + 1];
+            double z = points[i * 3 + 2];
+            apply_rotation(matrix(i), x, y, z);
+            return x + y + z;
+        }));
+
+        // Location::convert_to_spherical
+        results.push_back(measure("convert_to_spherical", d.name, inputs, min_time, [&](size_t i) {
+            double rho, theta, phi;
+            Location::convert_to_spherical(points[i * 3 + 0], points[i * 3 + 1], points[i * 3 + 2], rho, theta, phi);
+            return rho + theta + phi;
+        }));
+    }
+
+    // Location::update_local_spherical (r, theta, and phi updates in turn, as the maneuver loops do)
+    for (const Angle_Distribution &d : angle_distributions) {
+        std::vector<double> values(inputs);
+        for (size_t i = 0; i < inputs; i++) {
+            values[i] = (i % 3 == 0) ? 1.0 + 99.0 * uniform(rng) : d.max_angle * (2.0 * uniform(rng) - 1.0);
+        }
+        Location location(0.0, 0.0, 1.0);
+        location.set_local_spherical(1.0, 0.0, 0.0);
+        results.push_back(measure("update_local_spherical", d.name, inputs, min_time, [&](size_t i) {
+            switch (i % 3) {
+                case 0 : location.update_local_spherical(Spherical_Coord::R,     values[i]); break;
+                case 1 : location.update_local_spherical(Spherical_Coord::Theta, values[i]); break;
+                default: location.update_local_spherical(Spherical_Coord::Phi,   values[i]); break;
+            }
+            return location.local_x;
+        }));
+    }
+
+    // compute_efficient_roll: uniform phi, and phi within 1e-9 rad of the quadrant boundaries (where the roll direction flips)
+    for (int kind = 0; kind < 2; kind++) {
+        std::vector<double> phis(inputs);
+        for (size_t i = 0; i < inputs; i++) {
+            phis[i] = (kind == 0) ? M_PI * (2.0 * uniform(rng) - 1.0)
+                                  : (static_cast<int>(rng() % 4) - 2) * (M_PI / 2.0) + 1e-9 * (2.0 * uniform(rng) - 1.0);
+        }
+        results.push_back(measure("compute_efficient_roll", (kind == 0) ? "uniform" : "quadrant-edge", inputs, min_time, [&](size_t i) {
+            double roll_angle, phi_offset;
+            Maneuver_Axis next_maneuver;
+            int next_sign;
+            compute_efficient_roll(phis[i], roll_angle, phi_offset, next_maneuver, next_sign);
+            return roll_angle + phi_offset + next_sign;
+        }));
+    }
+
+    // Reaction_Wheel::compute_maneuver (small angles never reach the coast phase, full range angles usually do)
+    {
+        Reaction_Wheel wheel(16.0 * (0.2 * 0.2) / 6.0);
+        for (const Angle_Distribution &d : angle_distributions) {
+            std::vector<double> angles(inputs);
+            for (size_t i = 0; i < inputs; i++) {
+                angles[i] = d.max_angle * (2.0 * uniform(rng) - 1.0);
+            }
+            results.push_back(measure("compute_maneuver", d.name, inputs, min_time, [&](size_t i) {
+                double t_accel, t_coast, t_decel, alpha;
+                wheel.compute_maneuver(angles[i], t_accel, t_coast, t_decel, alpha);
+                return t_accel + t_coast + t_decel + alpha;
+            }));
+        }
+    }
+
+    // Snapshot_Formatter (random dashboard states, with a status message and frame pacing, as during a realtime maneuver)
+    {
+        std::vector<Satellite_Snapshot> snapshots(256);
+        for (size_t i = 0; i < snapshots.size(); i++) {
+            Satellite_Snapshot &s = snapshots[i];
+            auto value = [&](double scale) { return scale * (2.0 * uniform(rng) - 1.0); };
+            s.frame    = i;
+            s.sim_time = 100.0 * uniform(rng);
+            for (int k = 0; k < 3; k++) {
+                s.targ_global[k] = value(5.0); s.curr_global[k] = value(5.0); s.targ_local[k] = value(5.0); s.curr_local[k] = value(5.0);
+                s.targ_spherical[k] = value(M_PI); s.curr_spherical[k] = value(M_PI);
+            }
+            s.attitude = Attitude(value(1.0), value(1.0), value(1.0), value(1.0));
+            s.attitude.normalize();
+            s.omega_roll = value(0.3); s.omega_pitch = value(0.3); s.omega_yaw = value(0.3);
+            s.saturation_roll = value(100.0); s.saturation_pitch = value(100.0); s.saturation_yaw = value(100.0);
+            s.zoom_dist = 1.0 + 4.0 * uniform(rng);
+            s.frame_time = 1.0 / 60.0 + value(1e-3); s.sleep_overshoot = 1e-4 * uniform(rng); s.missed_deadline = false;
+            s.frame_p50 = 1.0 / 60.0; s.frame_p99 = 0.017; s.jitter_p99 = 3e-4; s.overshoot_max = 2e-4;
+            s.frames_timed = 100 + i; s.frames_missed = 0;
+            s.status = Status_Message::Pitch_Coasting;
+            std::snprintf(s.message, sizeof(s.message), "%s", status_text(s.status));
+            s.catalog_name[0] = '\0'; s.catalog_angle = 0.0;
+        }
+        Snapshot_Formatter formatter;
+        results.push_back(measure("format_dashboard", "random", snapshots.size(), min_time, [&](size_t i) {
+            formatter.format_dashboard(snapshots[i]);
+            return static_cast<double>(formatter.size());
+        }));
+        results.push_back(measure("format_csv_row", "random", snapshots.size(), min_time, [&](size_t i) {
+            formatter.format_csv_row(snapshots[i]);
+            return static_cast<double>(formatter.size());
+        }));
+    }
+
+    // Target_Catalog::nearest (uniform random catalog directions of every size, uniform random query directions)
+    // and Fov_Query::find_passes (1 deg half angle, eigen-axis slews from the identity attitude to the same random directions)
+    {
+        struct Catalog_Size {
+            const char *name;
+            size_t targets;
+        };
+        const Catalog_Size catalog_sizes[] = {{"1k", 1000}, {"100k", 100000}, {"1M", 1000000}};
+
+        const size_t queries = 4096;
+        Reaction_Wheel wheel(16.0 * (0.2 * 0.2) / 6.0); // (same wheel as the satellite, for planning the slews)
+        std::normal_distribution<double> normal(0.0, 1.0); // (normally distributed components give uniform directions)
+        std::vector<double> directions(queries * 3);
+        for (double &d : directions) {
+            d = normal(rng);
+        }
+
+        for (const Catalog_Size &c : catalog_sizes) {
+            Target_Catalog catalog;
+            for (size_t i = 0; i < c.targets; i++) {
+                double x = normal(rng), y = normal(rng), z = normal(rng);
+                catalog.add(x, y, z, nullptr, 0);
+            }
+            catalog.build_index();
+            results.push_back(measure("catalog_nearest", c.name, queries, min_time, [&](size_t i) {
+                size_t index;
+                double angle;
+                catalog.nearest(directions[i * 3 + 0], directions[i * 3 + 1], directions[i * 3 + 2], index, angle);
+                return static_cast<double>(index) + angle;
+            }));
+
+            Fov_Query query(catalog);
+            std::vector<Fov_Pass> passes;
+            results.push_back(measure("fov_passes", c.name, 64, min_time, [&](size_t i) {
+                Reorientation_Plan plan;
+                plan_reorientation(Attitude(), 1.0, directions[i * 3 + 0], directions[i * 3 + 1], directions[i * 3 + 2], wheel, wheel, wheel, 1.5, plan, Planner_Mode::Eigen_Axis);
+                query.find_passes(Attitude(), plan, deg_to_rad, passes);
+                return static_cast<double>(passes.size());
+            }));
+        }
+    }
+
+    // Ideal_Cube_Sat::reorient, headless with the free-running clock (targets within 10 deg of the previous one, or anywhere)
+    for (int kind = 0; kind < 2; kind++) {
+
+        const size_t targets = 64;
+        std::vector<double> points(targets * 3);
+        double theta = 0.0;
+        double phi   = 0.0;
+        for (size_t i = 0; i < targets; i++) {
+            if (kind == 0) {
+                theta = std::fabs(theta + 10.0 * deg_to_rad * (2.0 * uniform(rng) - 1.0));
+                phi  += 10.0 * deg_to_rad * (2.0 * uniform(rng) - 1.0);
+            } else {
+                theta = acos(2.0 * uniform(rng) - 1.0);
+                phi   = 2.0 * M_PI * uniform(rng);
+            }
+            double r = 1.0 + 4.0 * uniform(rng);
+            points[i * 3 + 0] = r * sin(theta) * cos(phi);
+            points[i * 3 + 1] = r * sin(theta) * sin(phi);
+            points[i * 3 + 2] = r * cos(theta);
+        }
+
+        Ideal_Cube_Sat sat(Clock_Mode::Stepped, 1.0, true);
+        results.push_back(measure("reorient", (kind == 0) ? "small-step" : "uniform", targets, 4.0 * min_time, [&](size_t i) {
+            sat.set_target(points[i * 3 + 0], points[i * 3 + 1], points[i * 3 + 2]);
+            sat.reorient();
+            return sat.last_metrics.pointing_error;
+        }));
+    }
+
+    // write the results file
+    std::FILE *file = std::fopen(results_path, "w");
+    if (file == nullptr) {
+        std::cerr << "ERROR: Unable to open benchmark results file '" << results_path << "'" << std::endl;
+        return 1;
+    }
+    std::fputs("benchmark,distribution,ns_per_op,allocs_per_op,ops\n", file);
+    for (const Benchmark_Result &r : results) {
+        std::fprintf(file, "%s,%s,%.3f,%.4f,%llu\n", r.name.c_str(), r.distribution.c_str(), r.ns_per_op, r.allocs_per_op, r.ops);
+    }
+    if (std::fclose(file) != 0) {
+        std::cerr << "ERROR: Failed writing benchmark results file '" << results_path << "'" << std::endl;
+        return 1;
+    }
+
+    // no baseline, nothing to compare
+    if (baseline_path == nullptr) {
+        return 0;
+    }
+
+    // read the baseline results (keyed by benchmark and distribution)
+    std::ifstream baseline_file(baseline_path);
+    if (!baseline_file) {
+        std::cerr << "ERROR: Unable to open benchmark baseline file '" << baseline_path << "'" << std::endl;
+        return 1;
+    }
+    std::map<std::string, Benchmark_Result> baseline;
+    std::string line;
+    std::getline(baseline_file, line); // header row
+    while (std::getline(baseline_file, line)) {
+        char name[64];
+        char distribution[64];
+        Benchmark_Result r;
+        if (std::sscanf(line.c_str(), "%63[^,],%63[^,],%lf,%lf,%llu", name, distribution, &r.ns_per_op, &r.allocs_per_op, &r.ops) == 5) {
+            baseline[std::string(name) + "," + distribution] = r;
+        }
+    }
+
+    // compare (any extra allocation is a regression, timing gets some slack for noise)
+    int regressions = 0;
+    std::printf("\n%-28s %-14s %10s %s\n", "benchmark", "distribution", "vs base", "");
+    for (const Benchmark_Result &r : results) {
+
+        auto found = baseline.find(r.name + "," + r.distribution);
+        if (found == baseline.end()) {
+            std::printf("%-28s %-14s %10s\n", r.name.c_str(), r.distribution.c_str(), "new");
+            continue;
+        }
+
+        const Benchmark_Result &base = found->second;
+        double ratio = r.ns_per_op / base.ns_per_op;
+        bool slower       = (ratio > regression_ratio);
+        bool more_allocs  = (r.allocs_per_op > base.allocs_per_op + 1e-3);
+        std::printf("%-28s %-14s %9.2fx %s%s\n", r.name.c_str(), r.distribution.c_str(), ratio,
+                    slower ? " SLOWER" : "", more_allocs ? " MORE ALLOCATIONS" : "");
+        if (slower || more_allocs) {
+            regressions++;
+        }
+    }
+
+    if (regressions > 0) {
+        std::cout << regressions << " benchmark regressions versus '" << baseline_path << "'" << std::endl;
+        return 1;
+    }
+    std::cout << "No benchmark regressions versus '" << baseline_path << "'" << std::endl;
+    return 0;
+}
+
+// run reorientations with every planner mode on the dashboard and count the heap allocations of the maneuver and render loops once warmed up
+// (and of the telemetry recorder, if any), returns the process exit code (1 if anything allocated)
+int run_allocation_test(Telemetry_Recorder *recorder) {
+
+    // targets in every octant (so every maneuver axis and sign comes up), at different distances (so the zoom runs both ways)
+    const double targets[][3] = {
+        { 1.0,  2.0,  3.0}, {-2.0,  1.0,  0.5}, { 0.5, -3.0, -1.0}, {-1.0, -1.0,  2.0},
+        { 3.0, -0.5, -2.0}, {-0.5,  2.5, -1.5}, { 2.0,  2.0,  0.2}, {-3.0, -2.0, -3.0}
+    };
+    const int target_count = sizeof(targets) / sizeof(targets[0]);
+
+    const Planner_Mode modes[] = {Planner_Mode::Roll_Then_Tilt, Planner_Mode::Eigen_Axis, Planner_Mode::Concurrent};
+
+    // results per planner mode (printed after the dashboard is done with the console)
+    struct Mode_Result {
+        Planner_Mode mode;
+        unsigned long long frames;
+        unsigned long long drawn;
+        uint64_t allocations;
+    };
+    Mode_Result mode_results[3];
+
+    // (the satellite goes out of scope before the report, so the render thread has drawn its last frame)
+    {
+        // dashboard satellite on a fast warp clock (frames are paced in realtime, so the render thread draws nearly every one)
+        Ideal_Cube_Sat sat(Clock_Mode::Scaled, 50.0, false);
+        sat.set_recorder(recorder);
+
+        for (int m = 0; m < 3; m++) {
+
+            sat.set_planner_mode(modes[m]);
+
+            // warm up: the first reorientation of a mode may size buffers for good
+            sat.set_target(targets[0][0], targets[0][1], targets[0][2]);
+            sat.reorient();
+
+            // steady state: every other target, counting the allocations of all threads
+            unsigned long long published_start = sat.renderer.get_published();
+            unsigned long long drawn_start     = sat.renderer.get_drawn();
+            uint64_t allocs_start = allocation_count();
+            for (int i = 1; i < target_count; i++) {
+                sat.set_target(targets[i][0], targets[i][1], targets[i][2]);
+                sat.reorient();
+            }
+            mode_results[m].mode        = modes[m];
+            mode_results[m].allocations = allocation_count() - allocs_start;
+            mode_results[m].frames      = sat.renderer.get_published() - published_start;
+            mode_results[m].drawn       = sat.renderer.get_drawn() - drawn_start;
+        }
+    }
+
+    // report below the final dashboard frame (any allocation at all fails the test)
+    uint64_t total_allocations = 0;
+    for (const Mode_Result &r : mode_results) {
+        std::printf("%-10s %d reorientations, %llu frames (%llu drawn), %llu allocations (%.4f per frame)\n",
+                    planner_mode_name(r.mode), target_count - 1, r.frames, r.drawn, static_cast<unsigned long long>(r.allocations),
+                    (r.frames > 0) ? static_cast<double>(r.allocations) / static_cast<double>(r.frames) : 0.0);
+        total_allocations += r.allocations;
+    }
+    if (total_allocations > 0) {
+        std::cout << "FAILED: the maneuver and render loops allocated " << total_allocations << " times" << std::endl;
+        return 1;
+    }
+    std::cout << "PASSED: no heap allocations in the maneuver and render loops" << std::endl;
+    return 0;
+}
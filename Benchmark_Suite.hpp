@@ -0,0 +1,20 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+#include "Telemetry_Recorder.hpp"
+
+/* Microbenchmarks of the attitude math kernels and the full headless reorientation
+    - Every kernel runs over a few input distributions (small and full range angles, near-singular points, ...) drawn from a fixed seed,
+      so runs are comparable between builds and machines
+    - Each benchmark reports the best of five timed rounds in ns per operation, and the heap allocations per operation (see Allocation_Counter.hpp)
+    - Results are written as CSV and can be compared against an earlier results file to catch regressions
+*/
+
+// run every benchmark, write the results to a CSV file and compare them with a baseline results file (if any), returns the process exit code (1 on a regression)
+int run_benchmarks(const char *results_path, const char *baseline_path);
+
+// run reorientations with every planner mode on the dashboard and count the heap allocations of the maneuver and render loops once warmed up
+// (and of the telemetry recorder, if any), returns the process exit code (1 if anything allocated)
+int run_allocation_test(Telemetry_Recorder *recorder);
+
+#endif
@@ -0,0 +1,69 @@
+#include "Command_Queue.hpp"
+
+#include <iostream>
+
+// constructor (starts the input thread)
+Command_Queue::Command_Queue():
+
+    // nothing read yet
+    finished(false),
+
+    // start reading right away
+    input_thread(&Command_Queue::read_input, this)
+
+{
+}
+
+// destructor (waits for the input thread, which has exited once "quit" was read)
+Command_Queue::~Command_Queue() {
+    input_thread.join();
+}
+
+// take the oldest waiting command line, returns false if there is none
+bool Command_Queue::poll(std::string &command) {
+
+    std::lock_guard<std::mutex> lock(commands_mutex);
+    if (commands.empty()) {
+        return false;
+    }
+    command = commands.front();
+    commands.pop_front();
+    return true;
+}
+
+// take the oldest waiting command line, waits for one if there is none (returns false once no more will come)
+bool Command_Queue::wait(std::string &command) {
+
+    std::unique_lock<std::mutex> lock(commands_mutex);
+    arrived.wait(lock, [this] {return !commands.empty() || finished;});
+    if (commands.empty()) {
+        return false;
+    }
+    command = commands.front();
+    commands.pop_front();
+    return true;
+}
+
+// input thread loop
+void Command_Queue::read_input() {
+
+    std::string line;
+    while (true) {
+
+        // the end of input means there is nobody left to give commands
+        if (!std::getline(std::cin, line)) {
+            line = "quit";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(commands_mutex);
+            commands.push_back(line);
+            finished = (line == "quit");
+        }
+        arrived.notify_all();
+
+        if (line == "quit") {
+            break;
+        }
+    }
+}
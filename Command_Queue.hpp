@@ -0,0 +1,39 @@
+#ifndef COMMAND_QUEUE_HPP
+#define COMMAND_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/* Reads command lines from standard input on its own thread
+    - The main loop polls for commands once per frame and never waits for the user (wait() is only for when there is nothing else to do)
+    - The input thread exits after a "quit" line or the end of input (a "quit" command is queued for the end of input too)
+*/
+
+class Command_Queue {
+
+private:
+
+    std::deque<std::string> commands; // command lines waiting to be processed
+    std::mutex commands_mutex;        // guards commands and finished
+    std::condition_variable arrived;  // wakes up wait() when a command line is queued
+    bool finished;                    // true once the input thread has exited (no more command lines will come)
+    std::thread input_thread;         // reads standard input
+
+    void read_input(); // input thread loop
+
+public:
+
+    Command_Queue(); // constructor (starts the input thread)
+
+    ~Command_Queue(); // destructor (waits for the input thread, which has exited once "quit" was read)
+
+    bool poll(std::string &command); // take the oldest waiting command line, returns false if there is none
+
+    bool wait(std::string &command); // take the oldest waiting command line, waits for one if there is none (returns false once no more will come)
+
+};
+
+#endif
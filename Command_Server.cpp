@@ -0,0 +1,572 @@
+#include "Command_Server.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// constructor (doesn't open anything)
+Command_Server::Command_Server(Ideal_Cube_Sat &sat, Planner_Mode planner_mode):
+
+    // store the satellite every client commands
+    sat(sat)
+
+{
+    this->planner_mode = planner_mode;
+    listen_fd        = -1;
+    epoll_fd         = -1;
+    signal_fd        = -1;
+    subscribers      = 0;
+    requests         = 0;
+    targets_planned  = 0;
+    targets_executed = 0;
+    frames_streamed  = 0;
+    frames_dropped   = 0;
+}
+
+// true if any client is subscribed to the state stream
+bool Command_Server::is_streaming() {
+    return subscribers > 0;
+}
+
+// requests handled
+unsigned long long Command_Server::get_requests() {
+    return requests;
+}
+
+// targets planned by Plan requests
+unsigned long long Command_Server::get_targets_planned() {
+    return targets_planned;
+}
+
+// targets executed by Execute requests
+unsigned long long Command_Server::get_targets_executed() {
+    return targets_executed;
+}
+
+// state frames queued to subscribers
+unsigned long long Command_Server::get_frames_streamed() {
+    return frames_streamed;
+}
+
+// state frames skipped because a subscriber's backlog was full
+unsigned long long Command_Server::get_frames_dropped() {
+    return frames_dropped;
+}
+
+// append a frame to a client's output
+void Command_Server::queue_frame(Connection &client, uint16_t type, Server_Status status, uint32_t sequence, const void *data, size_t length) {
+
+    Server_Frame_Header header;
+    header.length   = static_cast<uint32_t>(length);
+    header.type     = type;
+    header.status   = static_cast<uint16_t>(status);
+    header.sequence = sequence;
+
+    const char *header_bytes = reinterpret_cast<const char *>(&header);
+    client.output.insert(client.output.end(), header_bytes, header_bytes + sizeof(header));
+    if (length > 0) {
+        const char *data_bytes = static_cast<const char *>(data);
+        client.output.insert(client.output.end(), data_bytes, data_bytes + length);
+    }
+}
+
+// queue a physics frame to every subscriber (called by Ideal_Cube_Sat::print_info)
+void Command_Server::stream(const Satellite_Snapshot &snapshot) {
+
+    if (subscribers == 0) {
+        return;
+    }
+
+    // every subscriber gets the same record
+    Telemetry_Record record;
+    fill_telemetry_record(snapshot, record);
+
+    for (auto &entry : connections) {
+
+        Connection &client = entry.second;
+        if (client.decimation == 0 || snapshot.frame % client.decimation != 0) {
+            continue;
+        }
+
+        // a client that isn't keeping up misses frames (its replies are still always queued)
+        if (client.output.size() - client.output_sent >= max_backlog) {
+            frames_dropped++;
+            continue;
+        }
+        queue_frame(client, static_cast<uint16_t>(Server_Message::State), Server_Status::Ok, 0, &record, sizeof(record));
+        frames_streamed++;
+
+        // a long Execute streams many frames before the loop gets back to epoll, so hand them over as they pile up
+        // (a failed connection is closed once epoll reports it)
+        if (client.output.size() - client.output_sent >= flush_threshold) {
+            flush_client(client);
+        }
+    }
+}
+
+// true if a requested target can be pointed at (finite and not the origin, anything else would reach the planner with no direction)
+static bool is_valid_target(const Server_Target &target) {
+    return std::isfinite(target.x) && std::isfinite(target.y) && std::isfinite(target.z) && !(target.x == 0.0 && target.y == 0.0 && target.z == 0.0);
+}
+
+// handle one request, returns false if the connection has to be closed
+bool Command_Server::handle_frame(Connection &client, const Server_Frame_Header &header, const char *data) {
+
+    requests++;
+    uint16_t reply_type = header.type | server_reply_flag;
+
+    switch (static_cast<Server_Message>(header.type)) {
+
+        case Server_Message::Plan:
+        case Server_Message::Execute: {
+
+            // batch header, then exactly count targets
+            Server_Batch_Header batch;
+            if (header.length < sizeof(batch)) {
+                queue_frame(client, reply_type, Server_Status::Bad_Request, header.sequence, nullptr, 0);
+                return true;
+            }
+            std::memcpy(&batch, data, sizeof(batch));
+            if (batch.count > server_max_batch) {
+                queue_frame(client, reply_type, Server_Status::Too_Many, header.sequence, nullptr, 0);
+                return true;
+            }
+            if (header.length != sizeof(batch) + batch.count * sizeof(Server_Target) || batch.planner > 3) {
+                queue_frame(client, reply_type, Server_Status::Bad_Request, header.sequence, nullptr, 0);
+                return true;
+            }
+            const char *targets = data + sizeof(batch);
+
+            // use the requested planner mode for this batch only
+            sat.set_planner_mode((batch.planner == 0) ? planner_mode : static_cast<Planner_Mode>(batch.planner - 1));
+
+            if (static_cast<Server_Message>(header.type) == Server_Message::Plan) {
+
+                // plan every target from the current attitude (closed form, the satellite doesn't move)
+                payload.resize(batch.count * sizeof(Server_Plan_Result));
+                Reorientation_Plan plan;
+                for (uint32_t i = 0; i < batch.count; i++) {
+
+                    Server_Target target;
+                    std::memcpy(&target, targets + i * sizeof(target), sizeof(target));
+
+                    Server_Plan_Result result = Server_Plan_Result();
+                    if (is_valid_target(target)) {
+                        sat.plan_reorientation(target.x, target.y, target.z, plan);
+                        result.slew_time          = plan.slew_time;
+                        result.total_time         = plan.total_time;
+                        result.time_saved         = plan.time_saved;
+                        result.final_attitude[0]  = static_cast<float>(plan.final_attitude.w);
+                        result.final_attitude[1]  = static_cast<float>(plan.final_attitude.x);
+                        result.final_attitude[2]  = static_cast<float>(plan.final_attitude.y);
+                        result.final_attitude[3]  = static_cast<float>(plan.final_attitude.z);
+                        result.peak_saturation[0] = static_cast<float>(plan.peak_saturation_roll);
+                        result.peak_saturation[1] = static_cast<float>(plan.peak_saturation_pitch);
+                        result.peak_saturation[2] = static_cast<float>(plan.peak_saturation_yaw);
+                        result.valid              = 1;
+                    }
+                    std::memcpy(&payload[i * sizeof(result)], &result, sizeof(result));
+                }
+                targets_planned += batch.count;
+
+            } else {
+
+                // execute every target in order (subscribers get the frames as they are simulated)
+                payload.resize(batch.count * sizeof(Server_Execute_Result));
+                for (uint32_t i = 0; i < batch.count; i++) {
+
+                    Server_Target target;
+                    std::memcpy(&target, targets + i * sizeof(target), sizeof(target));
+
+                    Server_Execute_Result result = Server_Execute_Result();
+                    if (is_valid_target(target) && sat.set_target(target.x, target.y, target.z)) {
+                        sat.reorient();
+                        const Reorient_Metrics &m = sat.last_metrics;
+                        const Attitude &attitude  = sat.get_attitude();
+                        result.slew_time          = m.plan.slew_time;
+                        result.total_time         = m.plan.total_time;
+                        result.pointing_error     = m.pointing_error;
+                        result.final_attitude[0]  = static_cast<float>(attitude.w);
+                        result.final_attitude[1]  = static_cast<float>(attitude.x);
+                        result.final_attitude[2]  = static_cast<float>(attitude.y);
+                        result.final_attitude[3]  = static_cast<float>(attitude.z);
+                        result.final_focus[0]     = static_cast<float>(sat.curr_point.global_x);
+                        result.final_focus[1]     = static_cast<float>(sat.curr_point.global_y);
+                        result.final_focus[2]     = static_cast<float>(sat.curr_point.global_z);
+                        result.peak_saturation[0] = static_cast<float>(m.peak_saturation_roll);
+                        result.peak_saturation[1] = static_cast<float>(m.peak_saturation_pitch);
+                        result.peak_saturation[2] = static_cast<float>(m.peak_saturation_yaw);
+                        result.valid              = 1;
+                        targets_executed++;
+                    }
+                    std::memcpy(&payload[i * sizeof(result)], &result, sizeof(result));
+                }
+            }
+
+            sat.set_planner_mode(planner_mode);
+            queue_frame(client, reply_type, Server_Status::Ok, header.sequence, payload.data(), payload.size());
+            return true;
+        }
+
+        case Server_Message::Subscribe: {
+
+            uint32_t decimation;
+            if (header.length != sizeof(decimation)) {
+                queue_frame(client, reply_type, Server_Status::Bad_Request, header.sequence, nullptr, 0);
+                return true;
+            }
+            std::memcpy(&decimation, data, sizeof(decimation));
+
+            // keep the subscriber count in step (the satellite only fills in snapshots while someone is listening)
+            if (client.decimation == 0 && decimation != 0) {
+                subscribers++;
+            } else if (client.decimation != 0 && decimation == 0) {
+                subscribers--;
+            }
+            client.decimation = decimation;
+
+            queue_frame(client, reply_type, Server_Status::Ok, header.sequence, nullptr, 0);
+            return true;
+        }
+
+        case Server_Message::Get_State: {
+
+            if (header.length != 0) {
+                queue_frame(client, reply_type, Server_Status::Bad_Request, header.sequence, nullptr, 0);
+                return true;
+            }
+
+            // state between maneuvers (the same fields a streamed frame has)
+            Satellite_Snapshot snapshot = Satellite_Snapshot();
+            const Attitude &attitude = sat.get_attitude();
+            snapshot.targ_global[0]    = sat.targ_point.global_x;  snapshot.targ_global[1]    = sat.targ_point.global_y;     snapshot.targ_global[2]    = sat.targ_point.global_z;
+            snapshot.curr_global[0]    = sat.curr_point.global_x;  snapshot.curr_global[1]    = sat.curr_point.global_y;     snapshot.curr_global[2]    = sat.curr_point.global_z;
+            snapshot.targ_local[0]     = sat.targ_point.local_x;   snapshot.targ_local[1]     = sat.targ_point.local_y;      snapshot.targ_local[2]     = sat.targ_point.local_z;
+            snapshot.curr_local[0]     = sat.curr_point.local_x;   snapshot.curr_local[1]     = sat.curr_point.local_y;      snapshot.curr_local[2]     = sat.curr_point.local_z;
+            snapshot.targ_spherical[0] = sat.targ_point.local_r;   snapshot.targ_spherical[1] = sat.targ_point.local_theta;  snapshot.targ_spherical[2] = sat.targ_point.local_phi;
+            snapshot.curr_spherical[0] = sat.curr_point.local_r;   snapshot.curr_spherical[1] = sat.curr_point.local_theta;  snapshot.curr_spherical[2] = sat.curr_point.local_phi;
+            snapshot.attitude          = attitude;
+            snapshot.saturation_roll   = sat.reaction_wheel_roll.saturation;
+            snapshot.saturation_pitch  = sat.reaction_wheel_pitch.saturation;
+            snapshot.saturation_yaw    = sat.reaction_wheel_yaw.saturation;
+            snapshot.zoom_dist         = sat.curr_point.local_r;
+
+            Telemetry_Record record;
+            fill_telemetry_record(snapshot, record);
+            queue_frame(client, reply_type, Server_Status::Ok, header.sequence, &record, sizeof(record));
+            return true;
+        }
+
+        default:
+            queue_frame(client, reply_type, Server_Status::Unknown_Type, header.sequence, nullptr, 0);
+            return true;
+    }
+}
+
+#ifdef __linux__
+
+// destructor (closes every socket and removes the socket file)
+Command_Server::~Command_Server() {
+
+    for (auto &entry : connections) {
+        close(entry.first);
+    }
+    if (signal_fd >= 0) {
+        close(signal_fd);
+    }
+    if (epoll_fd >= 0) {
+        close(epoll_fd);
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+    }
+    if (!socket_path.empty()) {
+        unlink(socket_path.c_str());
+    }
+}
+
+// bind and listen on a Unix domain socket (a stale socket file is replaced), returns false on failure
+bool Command_Server::start(const char *socket_path) {
+
+    // the path has to fit the socket address
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (std::strlen(socket_path) >= sizeof(address.sun_path)) {
+        std::cerr << "ERROR: Socket path '" << socket_path << "' is too long (at most " << sizeof(address.sun_path) - 1 << " characters)" << std::endl;
+        return false;
+    }
+    std::strcpy(address.sun_path, socket_path);
+
+    // a socket file left behind by an earlier server is replaced, anything else at that path is left alone (and bind fails)
+    struct stat file_stat;
+    if (stat(socket_path, &file_stat) == 0 && S_ISSOCK(file_stat.st_mode)) {
+        unlink(socket_path);
+    }
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        std::cerr << "ERROR: Unable to bind socket '" << socket_path << "' (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    this->socket_path = socket_path;
+    if (listen(listen_fd, SOMAXCONN) != 0) {
+        std::cerr << "ERROR: Unable to listen on socket '" << socket_path << "' (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    // SIGINT and SIGTERM are read in the event loop instead of killing the process (so the socket file gets removed)
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+    signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    // watch the listening socket and the signals
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (signal_fd < 0 || epoll_fd < 0) {
+        std::cerr << "ERROR: Unable to set up the server event loop (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    epoll_event event;
+    event.events  = EPOLLIN;
+    event.data.fd = listen_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.fd = signal_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &event);
+
+    return true;
+}
+
+// handle clients until SIGINT or SIGTERM
+void Command_Server::run() {
+
+    if (epoll_fd < 0) {
+        return;
+    }
+
+    const int max_events = 64;
+    epoll_event events[max_events];
+    bool running = true;
+    while (running) {
+
+        int count = epoll_wait(epoll_fd, events, max_events, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "ERROR: Server event loop failed (" << std::strerror(errno) << ")" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                accept_clients();
+                continue;
+            }
+            if (fd == signal_fd) {
+                running = false;
+                continue;
+            }
+
+            // the client may already be gone (closed while handling an earlier event)
+            auto found = connections.find(fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            Connection &client = found->second;
+
+            bool open = true;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                open = read_client(client);
+            }
+            if (open && (events[i].events & EPOLLOUT)) {
+                open = flush_client(client);
+            }
+            if (!open) {
+                close_client(fd);
+            }
+        }
+
+        // send what the requests queued (replies, and state frames streamed to every subscriber), epoll finishes the rest
+        for (auto entry = connections.begin(); entry != connections.end(); ) {
+            Connection &client = entry->second;
+            if (client.output_sent < client.output.size() && !flush_client(client)) {
+                int fd = entry->first;
+                ++entry;
+                close_client(fd);
+                continue;
+            }
+            watch_client(client);
+            ++entry;
+        }
+    }
+}
+
+// accept every waiting connection
+void Command_Server::accept_clients() {
+
+    while (true) {
+
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // (EAGAIN once there are no more, anything else is the client's problem)
+        }
+
+        Connection &client = connections[fd];
+        client.fd          = fd;
+        client.output_sent = 0;
+        client.decimation  = 0;
+        client.writing     = false;
+
+        epoll_event event;
+        event.events  = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+// read what has arrived and handle every whole frame, returns false if the connection has to be closed
+bool Command_Server::read_client(Connection &client) {
+
+    // read until the socket is drained
+    char buffer[1 << 16];
+    bool hung_up = false;
+    while (true) {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            client.input.insert(client.input.end(), buffer, buffer + received);
+            continue;
+        }
+        if (received == 0) {
+            hung_up = true; // (a client may stop sending and still wait for its replies)
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    // handle every whole frame (the header is copied out, the buffer has no alignment guarantee)
+    size_t offset = 0;
+    bool   open   = true;
+    while (open && client.input.size() - offset >= sizeof(Server_Frame_Header)) {
+
+        Server_Frame_Header header;
+        std::memcpy(&header, &client.input[offset], sizeof(header));
+        if (header.length > server_max_frame) {
+            open = false; // can't be a valid request, and the stream can't be resynchronized
+            break;
+        }
+        if (client.input.size() - offset - sizeof(header) < header.length) {
+            break; // rest of the frame hasn't arrived yet
+        }
+
+        open    = handle_frame(client, header, &client.input[offset + sizeof(header)]);
+        offset += sizeof(header) + header.length;
+    }
+    client.input.erase(client.input.begin(), client.input.begin() + offset);
+
+    // a client that hung up gets whatever replies the socket still takes, then the connection is closed
+    if (hung_up && open) {
+        flush_client(client);
+        return false;
+    }
+
+    return open;
+}
+
+// write as much queued output as the socket takes, returns false if the connection failed
+bool Command_Server::flush_client(Connection &client) {
+
+    while (client.output_sent < client.output.size()) {
+        ssize_t written = send(client.fd, client.output.data() + client.output_sent, client.output.size() - client.output_sent, MSG_NOSIGNAL);
+        if (written >= 0) {
+            client.output_sent += static_cast<size_t>(written);
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    // drop what went out (the buffer keeps its capacity)
+    client.output.erase(client.output.begin(), client.output.begin() + client.output_sent);
+    client.output_sent = 0;
+    return true;
+}
+
+// have epoll report writability only while the client has output queued
+void Command_Server::watch_client(Connection &client) {
+
+    bool pending = client.output_sent < client.output.size();
+    if (pending == client.writing) {
+        return;
+    }
+
+    epoll_event event;
+    event.events  = pending ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.fd = client.fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client.fd, &event);
+    client.writing = pending;
+}
+
+// drop a client
+void Command_Server::close_client(int fd) {
+
+    auto found = connections.find(fd);
+    if (found == connections.end()) {
+        return;
+    }
+    if (found->second.decimation != 0) {
+        subscribers--;
+    }
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(found);
+}
+
+#else
+
+// destructor (nothing was opened)
+Command_Server::~Command_Server() {
+}
+
+// Unix domain sockets with epoll are Linux only (the server isn't available on other platforms)
+bool Command_Server::start(const char *socket_path) {
+    std::cerr << "ERROR: Server mode needs Linux (Unix domain socket and epoll), unable to serve on '" << socket_path << "'" << std::endl;
+    return false;
+}
+
+// handle clients until SIGINT or SIGTERM (never started)
+void Command_Server::run() {
+}
+
+// write as much queued output as the socket takes (there are never any clients)
+bool Command_Server::flush_client(Connection &client) {
+    return true;
+}
+
+#endif
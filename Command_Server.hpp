@@ -0,0 +1,93 @@
+#ifndef COMMAND_SERVER_HPP
+#define COMMAND_SERVER_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Ideal_Cube_Sat.hpp"
+#include "Server_Protocol.hpp"
+
+/* Local command and telemetry server (Linux only: Unix domain stream socket, epoll event loop on the calling thread)
+    - Any number of clients connect to the socket and send Server_Protocol.hpp requests, they all command the same headless satellite
+    - Sockets are non-blocking and the loop never waits on one client: a request is handled as soon as its whole frame has arrived,
+      replies and streamed state are queued per client and written as fast as the socket takes them
+    - State frames are only queued while a client's unsent backlog is under max_backlog, so a stalled client costs itself dropped frames, not memory or latency
+    - Stops on SIGINT or SIGTERM (read through a signalfd in the same loop) and removes the socket file
+*/
+
+class Command_Server {
+
+private:
+
+    // one connected client
+    struct Connection {
+        int fd;                   // client socket
+        std::vector<char> input;  // bytes received that don't make up a whole frame yet
+        std::vector<char> output; // bytes queued for the client (the first output_sent of them already written)
+        size_t output_sent;       // bytes of output already written
+        uint32_t decimation;      // stream every Nth physics frame (0 when not subscribed)
+        bool writing;             // true if epoll is watching for the socket to become writable
+    };
+
+    Ideal_Cube_Sat &sat;          // satellite every client commands (headless)
+    Planner_Mode planner_mode;    // planner mode of requests that don't pick one
+    std::string socket_path;      // path the socket is bound to (empty until start() binds it)
+    int listen_fd;                // listening socket (-1 when not started)
+    int epoll_fd;                 // epoll instance (-1 when not started)
+    int signal_fd;                // signalfd of SIGINT and SIGTERM (-1 when not started)
+    std::unordered_map<int, Connection> connections; // connected clients by socket (references stay valid while others come and go)
+    size_t subscribers;           // number of clients with a state stream
+    std::vector<char> payload;    // reply payload being built (keeps its capacity between requests)
+    unsigned long long requests;        // requests handled
+    unsigned long long targets_planned; // targets planned by Plan requests
+    unsigned long long targets_executed; // targets executed by Execute requests
+    unsigned long long frames_streamed; // state frames queued to subscribers
+    unsigned long long frames_dropped;  // state frames skipped because a subscriber's backlog was full
+
+    static const size_t max_backlog     = 1 << 20; // bytes of unsent output past which state frames are dropped for a client
+    static const size_t flush_threshold = 1 << 16; // bytes of unsent output past which streaming writes right away (during a long Execute)
+
+    void accept_clients(); // accept every waiting connection
+
+    bool read_client(Connection &client); // read what has arrived and handle every whole frame, returns false if the connection has to be closed
+
+    bool handle_frame(Connection &client, const Server_Frame_Header &header, const char *data); // handle one request, returns false if the connection has to be closed
+
+    void queue_frame(Connection &client, uint16_t type, Server_Status status, uint32_t sequence, const void *data, size_t length); // append a frame to a client's output
+
+    bool flush_client(Connection &client); // write as much queued output as the socket takes, returns false if the connection failed
+
+    void watch_client(Connection &client); // have epoll report writability only while the client has output queued
+
+    void close_client(int fd); // drop a client
+
+public:
+
+    Command_Server(Ideal_Cube_Sat &sat, Planner_Mode planner_mode); // constructor (doesn't open anything)
+
+    ~Command_Server(); // destructor (closes every socket and removes the socket file)
+
+    Command_Server(const Command_Server &) = delete;            // sockets can't be shared between objects
+    Command_Server &operator=(const Command_Server &) = delete; // sockets can't be shared between objects
+
+    bool start(const char *socket_path); // bind and listen on a Unix domain socket (a stale socket file is replaced), returns false on failure
+
+    void run(); // handle clients until SIGINT or SIGTERM
+
+    bool is_streaming(); // true if any client is subscribed to the state stream
+
+    void stream(const Satellite_Snapshot &snapshot); // queue a physics frame to every subscriber (called by Ideal_Cube_Sat::print_info)
+
+    unsigned long long get_requests(); // requests handled
+
+    unsigned long long get_targets_planned(); // targets planned by Plan requests
+
+    unsigned long long get_targets_executed(); // targets executed by Execute requests
+
+    unsigned long long get_frames_streamed(); // state frames queued to subscribers
+
+    unsigned long long get_frames_dropped(); // state frames skipped because a subscriber's backlog was full
+
+};
+
+#endif
@@ -1,33 +1,35 @@
 #include "Console_Manager.hpp"
 
+#include <cmath>
+#include <cstdio>
+
 // constructor
-Console_Manager::Console_Manager() {
+Console_Manager::Console_Manager():
+
+    // dashboard frame (wider and taller than anything update() prints)
+    screen(20, 120)
 
-    // get handle to the console window
-    consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+{
 }
 
-// get new target point from user
-void Console_Manager::get_new_target(double &new_x, double &new_y, double &new_z)
+// get new target point from user (command lines come from the input thread), returns false on "quit"
+bool Console_Manager::get_new_target(Command_Queue &commands, double &new_x, double &new_y, double &new_z)
 {
     // loop until valid input is received
+    std::string line;
     while (true){
 
-        // prompt user and wait to parse cin for new values
-        std::cout << "Enter the new target coordinates (x y z): ";
-        std::cin >> new_x >> new_y >> new_z;
+        // prompt user and wait for the next line from the input thread (it may already have been typed during the last maneuver)
+        std::cout << "Enter the new target coordinates (x y z), or quit: " << std::flush;
+        if (!commands.wait(line) || line == "quit") {
+            return false;
+        }
 
-        if (std::cin.fail()) { // if format of cin is wrong, ask the user to try again
+        if (!parse_target(line, new_x, new_y, new_z)) { // if format of the line is wrong, ask the user to try again
 
             // display error message
             std::cerr << "Invalid input. Please enter 3 signed numbers seperated by spaces (x y z)." << std::endl;
 
-            // clear the error state
-            std::cin.clear();
-
-            // discard invalid input from the input buffer
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
             continue;
 
         } else if (new_x == 0.0 && new_y == 0.0 && new_z == 0.0) { // if user specified (0, 0, 0), ask the user to try again
@@ -35,116 +37,51 @@ void Console_Manager::get_new_target(double &new_x, double &new_y, double &new_z
             // display error message
             std::cerr << "(0 0 0) is not a supported input. Please enter 3 signed numbers seperated by spaces (x y z)." << std::endl;
 
-            // clear the error state
-            std::cin.clear();
-
-            // discard invalid input from the input buffer
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
             continue;
         }
 
         // clear the console buffer
         clear_buffer();
 
-        // if get here then the input is valid, break out of the loop
-        break;
+        // if get here then the input is valid
+        return true;
     }
 }
 
-// print the current state of the satellite
-void Console_Manager::update(double x_targ            , double y_targ             , double z_targ           , 
-                             double x_curr            , double y_curr             , double z_curr           , 
-                             double x_l_targ          , double y_l_targ           , double z_l_targ         , 
-                             double x_l_curr          , double y_l_curr           , double z_l_curr         , 
-                             double r_targ            , double theta_targ         , double phi_targ         , 
-                             double r_curr            , double theta_curr         , double phi_curr         , 
-                             double rot_mat[3][3]     , double rot_mat_T[3][3]    ,
-                             double omega_roll        , double omega_pitch        , double omega_yaw        , 
-                             double rw_saturation_roll, double rw_saturation_pitch, double rw_saturation_yaw, 
-                             double zoom_dist         , std::string message)
+// read "x y z" from a command line, returns false unless it holds exactly 3 numbers
+bool Console_Manager::parse_target(const std::string &line, double &x, double &y, double &z)
 {
-
-    // set the cursor position to the top left corner of the console window
-    SetConsoleCursorPosition(consoleHandle, {0, 0});
-
-    // get the currently focused planet string using helper function
-    std::string planet;
-    determine_focused_planet(x_curr, y_curr, z_curr, planet);
-
-    // Convert angular velocity into deg/s for display purposes
-    omega_roll  *= 180 / M_PI;
-    omega_pitch *= 180 / M_PI;
-    omega_yaw   *= 180 / M_PI;
-
-    // Convert spherical coordinates into deg for display purposes
-    theta_targ *= 180 / M_PI;
-    theta_curr *= 180 / M_PI;
-    phi_targ   *= 180 / M_PI;
-    phi_curr   *= 180 / M_PI;
-
-    // define the precision for all floating-point output
-    int precision = 2;
-
-    // Set the precision for all floating-point output
-    std::cout << std::fixed << std::setprecision(precision);
-
-    // set the width for each value field output (adds whitespace padding)
-    const int width = 5 + precision;
-
-    // print all information to the console (commented out lines are for debugging purposes)
-    std::cout << "Target    Focus Point [-]:        X:" << std::setw(width) << value_rounder(x_targ            , precision) << "     Y:" << std::setw(width) << value_rounder(y_targ             , precision) << "   Z:" << std::setw(width) << value_rounder(z_targ           , precision) << std::endl;
-    std::cout << "Sattelite Focus Point [-]:        X:" << std::setw(width) << value_rounder(x_curr            , precision) << "     Y:" << std::setw(width) << value_rounder(y_curr             , precision) << "   Z:" << std::setw(width) << value_rounder(z_curr           , precision) << std::endl; std::cout << std::endl;
-    // std::cout << "Target    Local Focus Point [-]:  X:" << std::setw(width) << value_rounder(x_l_targ          , precision) << "     Y:" << std::setw(width) << value_rounder(y_l_targ           , precision) << "   Z:" << std::setw(width) << value_rounder(z_l_targ         , precision) << std::endl;
-    // std::cout << "Sattelite Local Focus Point [-]:  X:" << std::setw(width) << value_rounder(x_l_curr          , precision) << "     Y:" << std::setw(width) << value_rounder(y_l_curr           , precision) << "   Z:" << std::setw(width) << value_rounder(z_l_curr         , precision) << std::endl; std::cout << std::endl;
-    // std::cout << "Target    Spherical Coords [-]:   R:" << std::setw(width) << value_rounder(r_targ            , precision) << " Theta:" << std::setw(width) << value_rounder(theta_targ         , precision) << " Phi:" << std::setw(width) << value_rounder(phi_targ         , precision) << std::endl;
-    // std::cout << "Sattelite Spherical Coords [-]:   R:" << std::setw(width) << value_rounder(r_curr            , precision) << " Theta:" << std::setw(width) << value_rounder(theta_curr         , precision) << " Phi:" << std::setw(width) << value_rounder(phi_curr         , precision) << std::endl; std::cout << std::endl;
-    // std::cout << "Sattelite Rotation Matrix [-]:      " << std::setw(width) << value_rounder(rot_mat[0][0]     , precision) << "       " << std::setw(width) << value_rounder(rot_mat[0][1]      , precision) << "     " << std::setw(width) << value_rounder(rot_mat[0][2]    , precision) << std::endl;
-    // std::cout << "                                    " << std::setw(width) << value_rounder(rot_mat[1][0]     , precision) << "       " << std::setw(width) << value_rounder(rot_mat[1][1]      , precision) << "     " << std::setw(width) << value_rounder(rot_mat[1][2]    , precision) << std::endl;
-    // std::cout << "                                    " << std::setw(width) << value_rounder(rot_mat[2][0]     , precision) << "       " << std::setw(width) << value_rounder(rot_mat[2][1]      , precision) << "     " << std::setw(width) << value_rounder(rot_mat[2][2]    , precision) << std::endl; std::cout << std::endl;
-    // std::cout << "Sattelite Rotation Matrix T [-]:    " << std::setw(width) << value_rounder(rot_mat_T[0][0]   , precision) << "       " << std::setw(width) << value_rounder(rot_mat_T[0][1]    , precision) << "     " << std::setw(width) << value_rounder(rot_mat_T[0][2]  , precision) << std::endl;
-    // std::cout << "                                    " << std::setw(width) << value_rounder(rot_mat_T[1][0]   , precision) << "       " << std::setw(width) << value_rounder(rot_mat_T[1][1]    , precision) << "     " << std::setw(width) << value_rounder(rot_mat_T[1][2]  , precision) << std::endl;
-    // std::cout << "                                    " << std::setw(width) << value_rounder(rot_mat_T[2][0]   , precision) << "       " << std::setw(width) << value_rounder(rot_mat_T[2][1]    , precision) << "     " << std::setw(width) << value_rounder(rot_mat_T[2][2]  , precision) << std::endl; std::cout << std::endl;
-    std::cout << "Sat. Angular Velocity [deg/s]: Roll:" << std::setw(width) << value_rounder(omega_roll        , precision) << " Pitch:" << std::setw(width) << value_rounder(omega_pitch        , precision) << " Yaw:" << std::setw(width) << value_rounder(omega_yaw        , precision) << std::endl;
-    std::cout << "Reaction Wheel Saturation [%]: Roll:" << std::setw(width) << value_rounder(rw_saturation_roll, precision) << " Pitch:" << std::setw(width) << value_rounder(rw_saturation_pitch, precision) << " Yaw:" << std::setw(width) << value_rounder(rw_saturation_yaw, precision) << std::endl; std::cout << std::endl;
-    std::cout << "Optical Zoom Distance [-]: " << zoom_dist << std::endl;
-    std::cout << std::endl;
-    std::cout << "Planet in Current Focused Octant: " << planet << "                                                  " << std::endl; // added whitespace padding to overwrite any residual text
-    std::cout << std::endl;
-    if (message != "") {
-        std::cout << message << "                                                  " << std::endl; // added whitespace padding to overwrite any residual text
-        std::cout << std::endl;
+    // anything but whitespace after the third number makes the line invalid, and so does "nan" or "inf" (sscanf takes them as numbers, std::cin never did)
+    char extra;
+    if (std::sscanf(line.c_str(), "%lf %lf %lf %c", &x, &y, &z, &extra) != 3) {
+        return false;
     }
+    return std::isfinite(x) && std::isfinite(y) && std::isfinite(z);
 }
 
-// clear the console buffer (fill with spaces)
-void Console_Manager::clear_buffer() {
+// print the state of the satellite in a snapshot
+void Console_Manager::update(const Satellite_Snapshot &snapshot)
+{
 
-    // get the console screen buffer info
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    COORD topLeft = {0, 0};
-    GetConsoleScreenBufferInfo(consoleHandle, &csbi);
+    // format the whole dashboard once into the formatter's buffer (see Snapshot_Formatter::format_dashboard for the layout)
+    formatter.format_dashboard(snapshot);
 
-    // fill the entire buffer with spaces
-    DWORD length = csbi.dwSize.X * csbi.dwSize.Y;
-    DWORD written;
-    FillConsoleOutputCharacter(consoleHandle, ' ', length, topLeft, &written);
-    FillConsoleOutputAttribute(consoleHandle, csbi.wAttributes, length, topLeft, &written);
+    // compose it into a blank frame (cells that end up the same as the last frame are never sent to the terminal)
+    screen.clear();
+    screen.print_lines(formatter.data(), formatter.size());
 
-    // set the cursor position to the top left corner of the console window
-    SetConsoleCursorPosition(consoleHandle, topLeft);
+    // send the changed cells to the terminal
+    screen.present();
 }
 
-// rounds values to a specified precision, ensures no negative zeros are printed
-double Console_Manager::value_rounder(double value, int precision) {
-
-    // round the value to the specified precision
-    value = round(value * pow(10, precision)) / pow(10, precision);
+// clear the console (the next update is drawn on a blank screen)
+void Console_Manager::clear_buffer() {
 
-    // if the value is zero, redefine to ensure it is positive zero
-    if (value == 0.0) {
-        value = 0.0;
-    }
+    // clear the terminal and move the cursor to the top left corner
+    screen.clear_terminal();
+}
 
-    return value;
-}
\ No newline at end of file
+// the console content is unknown (the user typed over it), the next update is drawn in full
+void Console_Manager::invalidate() {
+    screen.invalidate();
+}
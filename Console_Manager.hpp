@@ -4,37 +4,34 @@
 #include <iostream>
 #include <string>
 #include <cmath>
-#include <Windows.h>
-#include <iomanip>
+#include <limits>
 #include "Helper_Functions.hpp"
+#include "Screen_Buffer.hpp"
+#include "Satellite_Snapshot.hpp"
+#include "Snapshot_Formatter.hpp"
+#include "Command_Queue.hpp"
 
 class Console_Manager {
 
 private:
 
-    HANDLE consoleHandle; // handle to the console window
+    Screen_Buffer screen; // frame buffer of the dashboard (only changed cells are sent to the terminal)
+
+    Snapshot_Formatter formatter; // formats each snapshot into the dashboard text
 
 public: 
 
     Console_Manager(); // constructor declaration
 
-    void get_new_target(double &new_x, double &new_y, double &new_z); // get new target point from user
+    bool get_new_target(Command_Queue &commands, double &new_x, double &new_y, double &new_z); // get new target point from user (command lines come from the input thread), returns false on "quit"
+
+    static bool parse_target(const std::string &line, double &x, double &y, double &z); // read "x y z" from a command line, returns false unless it holds exactly 3 finite numbers
 
-    // print the current state of the satellite
-    void update(double x_targ            , double y_targ             , double z_targ           , 
-                double x_curr            , double y_curr             , double z_curr           , 
-                double x_l_targ          , double y_l_targ           , double z_l_targ         , 
-                double x_l_curr          , double y_l_curr           , double z_l_curr         , 
-                double r_targ            , double theta_targ         , double phi_targ         , 
-                double r_curr            , double theta_curr         , double phi_curr         , 
-                double rot_mat[3][3]     , double rot_mat_T[3][3]    ,
-                double omega_roll        , double omega_pitch        , double omega_yaw        , 
-                double rw_saturation_roll, double rw_saturation_pitch, double rw_saturation_yaw, 
-                double zoom_dist         , std::string message);
+    void update(const Satellite_Snapshot &snapshot); // print the state of the satellite in a snapshot
 
-    void clear_buffer(); // clear the console buffer (fill with spaces)
+    void clear_buffer(); // clear the console (the next update is drawn on a blank screen)
 
-    double value_rounder(double value, int precision); // rounds values to a specified precision, ensures no negative zeros are printed
+    void invalidate(); // the console content is unknown (the user typed over it), the next update is drawn in full
 
 };
 
@@ -0,0 +1,329 @@
+#include "Constellation.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CONSTELLATION_AVX2 1
+#else
+#define CONSTELLATION_AVX2 0
+#endif
+
+/* Notes:
+    - Both kernels compute the same thing: profile angle and rate at the current time, attitude = eigen-axis rotation * start attitude,
+      wheel rates and saturation, boresight in global coords, and the target in local spherical coords
+    - The attitude is recomputed from the start attitude every frame, so no error builds up during a slew
+    - The AVX2 kernel replaces the library sin/cos and acos/atan2 with its own approximations:
+        - sin/cos of the half slew angle (never more than pi/2) use their Taylor series up to x^17/x^18 (error below 1e-14)
+        - theta and phi use atan2, with a Cephes style rational approximation of atan on [0, 1] (error around 1e-16)
+    - MinGW g++ can't align the stack to 32 bytes, build with "-Wa,-muse-unaligned-vector-move" there so spilled AVX registers can't fault
+*/
+
+// constructor (every satellite starts with the identity attitude, pointing at (0, 0, 1))
+Constellation::Constellation(size_t count, const Satellite_Config &config):
+
+    // initialize the reaction wheels the same way as Ideal_Cube_Sat
+    roll_wheel( config.get_inertia(), config.max_torque, config.max_angular_momentum),
+    pitch_wheel(config.get_inertia(), config.max_torque, config.max_angular_momentum),
+    yaw_wheel(  config.get_inertia(), config.max_torque, config.max_angular_momentum)
+
+{
+    this->count = count;
+    zoom_rate   = config.zoom_rate;
+    use_simd    = simd_available();
+
+    // identity attitude, no slew in progress
+    q_w.assign(count, 1.0); q_x.assign(count, 0.0); q_y.assign(count, 0.0); q_z.assign(count, 0.0);
+    start_w.assign(count, 1.0); start_x.assign(count, 0.0); start_y.assign(count, 0.0); start_z.assign(count, 0.0);
+    axis_x.assign(count, 0.0); axis_y.assign(count, 1.0);
+    t_accel.assign(count, 0.0); t_coast.assign(count, 0.0); t_decel.assign(count, 0.0); alpha.assign(count, 0.0);
+    slew_time.assign(count, 0.0); elapsed.assign(count, 0.0);
+
+    // at rest
+    omega_pitch.assign(count, 0.0); omega_yaw.assign(count, 0.0);
+    saturation_pitch.assign(count, 0.0); saturation_yaw.assign(count, 0.0);
+
+    // pointing at the default starting location
+    boresight_x.assign(count, 0.0); boresight_y.assign(count, 0.0); boresight_z.assign(count, 1.0);
+    target_x.assign(count, 0.0); target_y.assign(count, 0.0); target_z.assign(count, 1.0);
+    target_r.assign(count, 1.0); target_theta.assign(count, 0.0); target_phi.assign(count, 0.0);
+}
+
+// plan an eigen-axis slew of one satellite from its current attitude to a target point (global cartesian coords)
+void Constellation::set_target(size_t index, double x, double y, double z) {
+
+    // the slew starts from wherever the satellite is now (renormalized, the attitude is carried over from slew to slew)
+    Attitude attitude(q_w[index], q_x[index], q_y[index], q_z[index]);
+    attitude.normalize();
+    start_w[index] = attitude.w; start_x[index] = attitude.x; start_y[index] = attitude.y; start_z[index] = attitude.z;
+
+    // plan the slew (zoom isn't modeled, so the zoom distance doesn't matter)
+    Reorientation_Plan plan;
+    plan_reorientation(attitude, 1.0, x, y, z, roll_wheel, pitch_wheel, yaw_wheel, zoom_rate, plan, Planner_Mode::Eigen_Axis);
+
+    // store the slew profile
+    axis_x[index]    = plan.eigen_axis[0];
+    axis_y[index]    = plan.eigen_axis[1];
+    t_accel[index]   = plan.eigen_t_accel;
+    t_coast[index]   = plan.eigen_t_coast;
+    t_decel[index]   = plan.eigen_t_decel;
+    alpha[index]     = plan.eigen_alpha;
+    slew_time[index] = plan.slew_time;
+    elapsed[index]   = 0.0;
+
+    // store the new target
+    target_x[index] = x;
+    target_y[index] = y;
+    target_z[index] = z;
+}
+
+// true once a satellite has finished its current slew
+bool Constellation::is_settled(size_t index) {
+    return elapsed[index] >= slew_time[index];
+}
+
+// advance every satellite by dt seconds
+void Constellation::step(double dt) {
+
+    // advance the slew clocks (the kernels evaluate every satellite at its elapsed time)
+    for (size_t i = 0; i < count; i++) {
+        elapsed[i] += dt;
+    }
+
+    if (use_simd) {step_avx2(0, count);  }
+    else          {step_scalar(0, count);}
+}
+
+// select the AVX2 kernel (ignored if the CPU doesn't support it)
+void Constellation::set_simd(bool enabled) {
+    use_simd = enabled && simd_available();
+}
+
+// true if step() uses the AVX2 kernel
+bool Constellation::get_simd() {
+    return use_simd;
+}
+
+// true if the CPU supports AVX2 and FMA
+bool Constellation::simd_available() {
+#if CONSTELLATION_AVX2
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+// reference kernel (Attitude, Location, and Helper_Functions math, one satellite at a time)
+void Constellation::step_scalar(size_t begin, size_t end) {
+
+    for (size_t i = begin; i < end; i++) {
+
+        // slew angle and rate at the current time
+        double angle, omega;
+        evaluate_bang_coast_bang(elapsed[i], alpha[i], t_accel[i], t_coast[i], t_decel[i], angle, omega);
+
+        // the satellite rotates by +angle about the eigen axis, so coordinates rotate by -angle
+        Attitude attitude = Attitude::from_axis_angle(axis_x[i], axis_y[i], 0.0, -angle) * Attitude(start_w[i], start_x[i], start_y[i], start_z[i]);
+        q_w[i] = attitude.w;
+        q_x[i] = attitude.x;
+        q_y[i] = attitude.y;
+        q_z[i] = attitude.z;
+
+        // the pitch (x) and yaw (y) wheels each carry their share of the rotation
+        omega_pitch[i]      = omega * axis_x[i];
+        omega_yaw[i]        = omega * axis_y[i];
+        saturation_pitch[i] = 100.0 * omega_pitch[i] / pitch_wheel.max_sat_omega;
+        saturation_yaw[i]   = 100.0 * omega_yaw[i]   / yaw_wheel.max_sat_omega;
+
+        // boresight in global coords
+        double bx = 0.0, by = 0.0, bz = 1.0;
+        attitude.inverse_rotate(bx, by, bz);
+        boresight_x[i] = bx;
+        boresight_y[i] = by;
+        boresight_z[i] = bz;
+
+        // target in local spherical coords
+        double tx = target_x[i], ty = target_y[i], tz = target_z[i];
+        attitude.rotate(tx, ty, tz);
+        Location::convert_to_spherical(tx, ty, tz, target_r[i], target_theta[i], target_phi[i]);
+    }
+}
+
+#if CONSTELLATION_AVX2
+
+#define AVX2_KERNEL __attribute__((target("avx2,fma"), always_inline)) static inline
+
+// sin and cos of four angles in [-pi/2, pi/2] (Taylor series, Horner form)
+AVX2_KERNEL void avx2_sincos(__m256d x, __m256d &s, __m256d &c) {
+
+    __m256d x2 = _mm256_mul_pd(x, x);
+
+    // sin(x) = x * (1 - x^2/3! + x^4/5! - ... + x^16/17!)
+    __m256d ps = _mm256_set1_pd( 1.0 / 355687428096000.0);
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 1307674368000.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd( 1.0 / 6227020800.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 39916800.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd( 1.0 / 362880.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 5040.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd( 1.0 / 120.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 6.0));
+    ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd( 1.0));
+    s  = _mm256_mul_pd(ps, x);
+
+    // cos(x) = 1 - x^2/2! + x^4/4! - ... + x^18/18!
+    __m256d pc = _mm256_set1_pd(-1.0 / 6402373705728000.0);
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd( 1.0 / 20922789888000.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 87178291200.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd( 1.0 / 479001600.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 3628800.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd( 1.0 / 40320.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 720.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd( 1.0 / 24.0));
+    pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 2.0));
+    c  = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd( 1.0));
+}
+
+// atan2 of four points, result in [-pi, pi] (atan2(0, 0) is 0, same as the C library)
+AVX2_KERNEL __m256d avx2_atan2(__m256d y, __m256d x) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d zero      = _mm256_setzero_pd();
+    const __m256d one       = _mm256_set1_pd(1.0);
+
+    // reduce to atan of a ratio in [0, 1]
+    __m256d ax  = _mm256_andnot_pd(sign_mask, x);
+    __m256d ay  = _mm256_andnot_pd(sign_mask, y);
+    __m256d num = _mm256_min_pd(ax, ay);
+    __m256d den = _mm256_max_pd(ax, ay);
+    __m256d t   = _mm256_div_pd(num, _mm256_blendv_pd(den, one, _mm256_cmp_pd(den, zero, _CMP_EQ_OQ)));
+
+    // ratios above 0.66 use atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    __m256d big  = _mm256_cmp_pd(t, _mm256_set1_pd(0.66), _CMP_GT_OQ);
+    __m256d base = _mm256_and_pd(big, _mm256_set1_pd(M_PI / 4.0));
+    t = _mm256_blendv_pd(t, _mm256_div_pd(_mm256_sub_pd(t, one), _mm256_add_pd(t, one)), big);
+
+    // atan(t) = t + t * z * P(z) / Q(z), z = t^2 (Cephes atan coefficients)
+    __m256d z = _mm256_mul_pd(t, t);
+    __m256d p = _mm256_set1_pd(-8.750608600031904122785e-1);
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.615753718733365076637e1));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-7.500855792314704667340e1));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.228866684490136173410e2));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-6.485021904942025371773e1));
+    __m256d q = _mm256_add_pd(z, _mm256_set1_pd(2.485846490142306297962e1));
+    q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(1.650270098316988542046e2));
+    q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(4.328810604912902668951e2));
+    q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(4.853903996359136964868e2));
+    q = _mm256_fmadd_pd(q, z, _mm256_set1_pd(1.945506571482613964425e2));
+    __m256d a = _mm256_add_pd(base, _mm256_fmadd_pd(_mm256_mul_pd(t, z), _mm256_div_pd(p, q), t));
+
+    // undo the reduction: swap of x and y, then the quadrant
+    a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(M_PI / 2.0), a), _mm256_cmp_pd(ay, ax, _CMP_GT_OQ));
+    a = _mm256_blendv_pd(a, _mm256_sub_pd(_mm256_set1_pd(M_PI), a), _mm256_cmp_pd(x, zero, _CMP_LT_OQ));
+    return _mm256_or_pd(a, _mm256_and_pd(y, sign_mask));
+}
+
+// rotate four vectors by four quaternions (same formula as Attitude::rotate, sign = -1 for Attitude::inverse_rotate)
+AVX2_KERNEL void avx2_rotate(__m256d w, __m256d x, __m256d y, __m256d z, double sign, __m256d &vx, __m256d &vy, __m256d &vz) {
+
+    // the inverse rotation uses the conjugate quaternion
+    __m256d s = _mm256_set1_pd(sign);
+    x = _mm256_mul_pd(x, s);
+    y = _mm256_mul_pd(y, s);
+    z = _mm256_mul_pd(z, s);
+
+    // t = 2 * (q x v)
+    __m256d two = _mm256_set1_pd(2.0);
+    __m256d tx  = _mm256_mul_pd(two, _mm256_fmsub_pd(y, vz, _mm256_mul_pd(z, vy)));
+    __m256d ty  = _mm256_mul_pd(two, _mm256_fmsub_pd(z, vx, _mm256_mul_pd(x, vz)));
+    __m256d tz  = _mm256_mul_pd(two, _mm256_fmsub_pd(x, vy, _mm256_mul_pd(y, vx)));
+
+    // v' = v + w*t + q x t
+    vx = _mm256_add_pd(_mm256_fmadd_pd(w, tx, vx), _mm256_fmsub_pd(y, tz, _mm256_mul_pd(z, ty)));
+    vy = _mm256_add_pd(_mm256_fmadd_pd(w, ty, vy), _mm256_fmsub_pd(z, tx, _mm256_mul_pd(x, tz)));
+    vz = _mm256_add_pd(_mm256_fmadd_pd(w, tz, vz), _mm256_fmsub_pd(x, ty, _mm256_mul_pd(y, tx)));
+}
+
+// AVX2/FMA kernel (four satellites at a time, remainder goes to the reference kernel)
+__attribute__((target("avx2,fma")))
+void Constellation::step_avx2(size_t begin, size_t end) {
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d sat_pitch = _mm256_set1_pd(100.0 / pitch_wheel.max_sat_omega);
+    const __m256d sat_yaw   = _mm256_set1_pd(100.0 / yaw_wheel.max_sat_omega);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+
+        // slew angle and rate at the current time (branch free: each phase's time is clamped to its own duration)
+        __m256d t  = _mm256_loadu_pd(&elapsed[i]);
+        __m256d ta = _mm256_loadu_pd(&t_accel[i]);
+        __m256d tc = _mm256_loadu_pd(&t_coast[i]);
+        __m256d td = _mm256_loadu_pd(&t_decel[i]);
+        __m256d a  = _mm256_loadu_pd(&alpha[i]);
+        __m256d pa = _mm256_min_pd(_mm256_max_pd(t, zero), ta);
+        __m256d pc = _mm256_min_pd(_mm256_max_pd(_mm256_sub_pd(t, ta), zero), tc);
+        __m256d pd = _mm256_min_pd(_mm256_max_pd(_mm256_sub_pd(_mm256_sub_pd(t, ta), tc), zero), td);
+        __m256d omega_peak = _mm256_mul_pd(a, pa);
+        __m256d omega = _mm256_mul_pd(a, _mm256_sub_pd(pa, pd));
+        __m256d angle = _mm256_mul_pd(_mm256_mul_pd(half, a), _mm256_sub_pd(_mm256_mul_pd(pa, pa), _mm256_mul_pd(pd, pd)));
+        angle = _mm256_fmadd_pd(omega_peak, _mm256_add_pd(pc, pd), angle);
+
+        // eigen-axis rotation of coordinates by -angle, composed with the start attitude
+        __m256d ex = _mm256_loadu_pd(&axis_x[i]);
+        __m256d ey = _mm256_loadu_pd(&axis_y[i]);
+        __m256d s, c;
+        avx2_sincos(_mm256_mul_pd(_mm256_set1_pd(-0.5), angle), s, c);
+        __m256d rx = _mm256_mul_pd(ex, s);
+        __m256d ry = _mm256_mul_pd(ey, s);
+        __m256d sw = _mm256_loadu_pd(&start_w[i]);
+        __m256d sx = _mm256_loadu_pd(&start_x[i]);
+        __m256d sy = _mm256_loadu_pd(&start_y[i]);
+        __m256d sz = _mm256_loadu_pd(&start_z[i]);
+        __m256d w = _mm256_fnmadd_pd(ry, sy, _mm256_fnmadd_pd(rx, sx, _mm256_mul_pd(c, sw)));
+        __m256d x = _mm256_fmadd_pd (ry, sz, _mm256_fmadd_pd (rx, sw, _mm256_mul_pd(c, sx)));
+        __m256d y = _mm256_fmadd_pd (ry, sw, _mm256_fnmadd_pd(rx, sz, _mm256_mul_pd(c, sy)));
+        __m256d z = _mm256_fnmadd_pd(ry, sx, _mm256_fmadd_pd (rx, sy, _mm256_mul_pd(c, sz)));
+        _mm256_storeu_pd(&q_w[i], w);
+        _mm256_storeu_pd(&q_x[i], x);
+        _mm256_storeu_pd(&q_y[i], y);
+        _mm256_storeu_pd(&q_z[i], z);
+
+        // the pitch (x) and yaw (y) wheels each carry their share of the rotation
+        __m256d op = _mm256_mul_pd(omega, ex);
+        __m256d oy = _mm256_mul_pd(omega, ey);
+        _mm256_storeu_pd(&omega_pitch[i], op);
+        _mm256_storeu_pd(&omega_yaw[i], oy);
+        _mm256_storeu_pd(&saturation_pitch[i], _mm256_mul_pd(op, sat_pitch));
+        _mm256_storeu_pd(&saturation_yaw[i], _mm256_mul_pd(oy, sat_yaw));
+
+        // boresight in global coords
+        __m256d bx = zero, by = zero, bz = _mm256_set1_pd(1.0);
+        avx2_rotate(w, x, y, z, -1.0, bx, by, bz);
+        _mm256_storeu_pd(&boresight_x[i], bx);
+        _mm256_storeu_pd(&boresight_y[i], by);
+        _mm256_storeu_pd(&boresight_z[i], bz);
+
+        // target in local spherical coords (theta = atan2(rho_xy, z) is the same angle as acos(z / r), without its loss of precision near 0)
+        __m256d vx = _mm256_loadu_pd(&target_x[i]);
+        __m256d vy = _mm256_loadu_pd(&target_y[i]);
+        __m256d vz = _mm256_loadu_pd(&target_z[i]);
+        avx2_rotate(w, x, y, z, 1.0, vx, vy, vz);
+        __m256d rho_xy2 = _mm256_fmadd_pd(vy, vy, _mm256_mul_pd(vx, vx));
+        __m256d phi     = avx2_atan2(vy, vx);
+        phi = _mm256_add_pd(phi, _mm256_and_pd(_mm256_cmp_pd(phi, zero, _CMP_LT_OQ), _mm256_set1_pd(2.0 * M_PI))); // phi in [0, 2pi)
+        _mm256_storeu_pd(&target_r[i], _mm256_sqrt_pd(_mm256_fmadd_pd(vz, vz, rho_xy2)));
+        _mm256_storeu_pd(&target_theta[i], avx2_atan2(_mm256_sqrt_pd(rho_xy2), vz));
+        _mm256_storeu_pd(&target_phi[i], phi);
+    }
+
+    // leftover satellites
+    step_scalar(i, end);
+}
+
+#else
+
+// AVX2/FMA kernel (not available on this architecture)
+void Constellation::step_avx2(size_t begin, size_t end) {
+    step_scalar(begin, end);
+}
+
+#endif
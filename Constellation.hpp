@@ -0,0 +1,82 @@
+#ifndef CONSTELLATION_HPP
+#define CONSTELLATION_HPP
+
+#include <vector>
+#include "Attitude.hpp"
+#include "Reaction_Wheel.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Satellite_Config.hpp"
+
+/* Fleet of identical satellites stepped together
+    - State is kept in structure-of-arrays form (one array per quantity, indexed by satellite) so the step kernels stream through memory and vectorize
+    - Every satellite slews with an eigen-axis profile (a single bang-coast-bang rotation, see plan_reorientation), optical zoom is not modeled
+    - Retargeting is planned one satellite at a time with the closed form planner, only step() is meant to be called every frame
+*/
+
+class Constellation {
+
+private:
+
+    Reaction_Wheel roll_wheel;  // roll  reaction wheel (identical for every satellite)
+    Reaction_Wheel pitch_wheel; // pitch reaction wheel (identical for every satellite)
+    Reaction_Wheel yaw_wheel;   // yaw   reaction wheel (identical for every satellite)
+    double zoom_rate;           // coordinate units/s (only used by the planner)
+    bool   use_simd;            // if true, step() uses the AVX2 kernel
+
+    void step_scalar(size_t begin, size_t end); // reference kernel (Attitude, Location, and Helper_Functions math, one satellite at a time)
+
+    void step_avx2(size_t begin, size_t end); // AVX2/FMA kernel (four satellites at a time, remainder goes to the reference kernel)
+
+public:
+
+    size_t count; // number of satellites
+
+    // attitude (unit quaternion, global to local cartesian coords)
+    std::vector<double> q_w, q_x, q_y, q_z;
+
+    // attitude at the start of the current slew
+    std::vector<double> start_w, start_x, start_y, start_z;
+
+    // current slew (unit eigen axis in local cartesian coords at the start of the slew, the axis has no z component)
+    std::vector<double> axis_x, axis_y;
+
+    // current slew bang-coast-bang profile
+    std::vector<double> t_accel;   // s
+    std::vector<double> t_coast;   // s
+    std::vector<double> t_decel;   // s
+    std::vector<double> alpha;     // rad/s^2
+    std::vector<double> slew_time; // s (total time of the current slew)
+    std::vector<double> elapsed;   // s (time since the current slew started)
+
+    // angular rates and reaction wheel saturation (the roll wheel is never used by an eigen-axis slew)
+    std::vector<double> omega_pitch;      // rad/s
+    std::vector<double> omega_yaw;        // rad/s
+    std::vector<double> saturation_pitch; // %
+    std::vector<double> saturation_yaw;   // %
+
+    // boresight (local +z axis) direction in global cartesian coords
+    std::vector<double> boresight_x, boresight_y, boresight_z;
+
+    // target point in global cartesian coords
+    std::vector<double> target_x, target_y, target_z;
+
+    // target point in local spherical coords (target_theta is the pointing error)
+    std::vector<double> target_r, target_theta, target_phi;
+
+    Constellation(size_t count, const Satellite_Config &config = Satellite_Config()); // constructor (every satellite starts with the identity attitude, pointing at (0, 0, 1))
+
+    void set_target(size_t index, double x, double y, double z); // plan an eigen-axis slew of one satellite from its current attitude to a target point (global cartesian coords)
+
+    bool is_settled(size_t index); // true once a satellite has finished its current slew
+
+    void step(double dt); // advance every satellite by dt seconds
+
+    void set_simd(bool enabled); // select the AVX2 kernel (ignored if the CPU doesn't support it)
+
+    bool get_simd(); // true if step() uses the AVX2 kernel
+
+    static bool simd_available(); // true if the CPU supports AVX2 and FMA
+
+};
+
+#endif
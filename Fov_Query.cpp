@@ -0,0 +1,149 @@
+#include "Fov_Query.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// constructor (the catalog must outlive the query and have its index built)
+Fov_Query::Fov_Query(const Target_Catalog &catalog):
+
+    // store the catalog to search
+    catalog(catalog)
+
+{
+}
+
+// how far a target is inside the cone t seconds into the slew (cosine of its angle from the boresight minus the cosine of the half angle, negative outside)
+double Fov_Query::cone_margin(const Attitude &attitude, const Reorientation_Plan &plan, double t, double cos_half_angle, const double target[3]) {
+
+    double x, y, z;
+    boresight_at(attitude, plan, t, x, y, z);
+    return x * target[0] + y * target[1] + z * target[2] - cos_half_angle;
+}
+
+// time a target crosses the edge of the cone between two times, one in view and one not (false position)
+double Fov_Query::find_crossing(const Attitude &attitude, const Reorientation_Plan &plan, double t_in, double t_out, double cos_half_angle, const double target[3]) {
+
+    // the margin is smooth and nearly linear between two samples, so the Illinois variant of false position gets to
+    // a microsecond in a few steps where bisection takes twenty (a bisection step is taken whenever it falls outside the interval)
+    double margin_in  = cone_margin(attitude, plan, t_in , cos_half_angle, target);
+    double margin_out = cone_margin(attitude, plan, t_out, cos_half_angle, target);
+    int    last_side  = 0; // +1 if the last step moved the in view end, -1 if it moved the other end
+    for (int i = 0; i < 64 && std::abs(t_out - t_in) > 1e-6; i++) {
+
+        double t = t_in + (t_out - t_in) * margin_in / (margin_in - margin_out);
+        if (!(std::min(t_in, t_out) < t && t < std::max(t_in, t_out))) {
+            t = (t_in + t_out) / 2.0;
+        }
+
+        // move the end on the same side as the new point, and halve the margin of the other end if it went stale twice in a row
+        double margin = cone_margin(attitude, plan, t, cos_half_angle, target);
+        if (margin >= 0.0) {
+            t_in = t;
+            margin_in = margin;
+            if (last_side == 1) {
+                margin_out /= 2.0;
+            }
+            last_side = 1;
+        } else {
+            t_out = t;
+            margin_out = margin;
+            if (last_side == -1) {
+                margin_in /= 2.0;
+            }
+            last_side = -1;
+        }
+    }
+    return (t_in + t_out) / 2.0;
+}
+
+// every pass of a catalog target through a field of view cone (half angle in rad) during the slew of a plan (attitude is the attitude the plan started from), replaces the contents of passes (in entry time order)
+void Fov_Query::find_passes(const Attitude &attitude, const Reorientation_Plan &plan, double half_angle, std::vector<Fov_Pass> &passes) {
+
+    passes.clear();
+    in_view.clear();
+    enter_times.clear();
+    if (catalog.size() == 0 || half_angle <= 0.0) {
+        return;
+    }
+
+    // fastest the boresight can move (pitch or yaw, or eigen-axis, rate plus the roll rate when they run together, the roll of a two step slew spins about the boresight)
+    double omega_max;
+    if (plan.mode == Planner_Mode::Eigen_Axis) {
+        omega_max = std::abs(plan.eigen_alpha * plan.eigen_t_accel);
+    } else if (plan.mode == Planner_Mode::Concurrent) {
+        omega_max = std::abs(plan.tilt_alpha * plan.tilt_t_accel) + std::abs(plan.roll_alpha * plan.roll_t_accel);
+    } else {
+        omega_max = std::abs(plan.tilt_alpha * plan.tilt_t_accel);
+    }
+
+    // sample so the boresight moves at most an eighth of the half angle between samples
+    double step    = half_angle / 8.0;
+    size_t samples = (omega_max > 0.0) ? static_cast<size_t>(std::ceil(plan.slew_time * omega_max / step)) : 0;
+    double dt      = (samples > 0) ? plan.slew_time / samples : 0.0;
+
+    // the index is asked with a slightly wider cone (float directions), every candidate is then checked exactly
+    double cos_half_angle = cos(half_angle);
+    double query_angle    = half_angle * (1.0 + 1e-4) + 1e-6;
+
+    for (size_t k = 0; k <= samples; k++) {
+
+        // targets in the cone at this sample
+        double t = (k == samples) ? plan.slew_time : k * dt;
+        double x, y, z;
+        boresight_at(attitude, plan, t, x, y, z);
+        catalog.within(x, y, z, query_angle, next_in_view);
+        size_t kept = 0;
+        for (size_t index : next_in_view) {
+            double target[3];
+            catalog.get_direction(index, target[0], target[1], target[2]);
+            if (x * target[0] + y * target[1] + z * target[2] >= cos_half_angle) {
+                next_in_view[kept++] = index;
+            }
+        }
+        next_in_view.resize(kept);
+
+        // merge with the previous sample (both in index order)
+        double t_prev = (k == 0) ? 0.0 : t - dt;
+        next_enter_times.resize(next_in_view.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < in_view.size() || j < next_in_view.size()) {
+
+            double target[3];
+            if (j == next_in_view.size() || (i < in_view.size() && in_view[i] < next_in_view[j])) {
+
+                // left the cone since the previous sample
+                catalog.get_direction(in_view[i], target[0], target[1], target[2]);
+                passes.push_back({in_view[i], enter_times[i], find_crossing(attitude, plan, t_prev, t, cos_half_angle, target)});
+                i++;
+
+            } else if (i == in_view.size() || next_in_view[j] < in_view[i]) {
+
+                // entered the cone since the previous sample (or was already in it when the slew started)
+                catalog.get_direction(next_in_view[j], target[0], target[1], target[2]);
+                next_enter_times[j] = (k == 0) ? 0.0 : find_crossing(attitude, plan, t, t_prev, cos_half_angle, target);
+                j++;
+
+            } else {
+
+                // still in the cone
+                next_enter_times[j] = enter_times[i];
+                i++;
+                j++;
+            }
+        }
+
+        in_view.swap(next_in_view);
+        enter_times.swap(next_enter_times);
+    }
+
+    // whatever is still in view stays in view until the end of the slew
+    for (size_t i = 0; i < in_view.size(); i++) {
+        passes.push_back({in_view[i], enter_times[i], plan.slew_time});
+    }
+
+    // report the passes in the order they started
+    std::sort(passes.begin(), passes.end(), [](const Fov_Pass &a, const Fov_Pass &b) {
+        return (a.t_enter != b.t_enter) ? a.t_enter < b.t_enter : a.target < b.target;
+    });
+}
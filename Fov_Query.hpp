@@ -0,0 +1,49 @@
+#ifndef FOV_QUERY_HPP
+#define FOV_QUERY_HPP
+
+#include <vector>
+#include "Attitude.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Target_Catalog.hpp"
+
+// one pass of a catalog target through the camera field of view during a slew
+struct Fov_Pass {
+    size_t target;  // catalog target index (see Target_Catalog::get_name)
+    double t_enter; // s (time into the slew the target entered the field of view, zero if it was already in view)
+    double t_exit;  // s (time into the slew the target left the field of view, the slew time if it is still in view at the end)
+};
+
+/* Swept field of view cone query over a planned slew
+    - The boresight path of the plan (boresight_at) is sampled closely enough that it moves at most an eighth of the field of view
+      half angle between samples, and the catalog index is asked for the targets in the cone at each sample
+    - A target that shows up at a sample and not at the previous one (or the other way around) entered (or left) the cone in between,
+      the crossing time is then found by false position on the exact boresight path
+    - Only the samples touch the index, so a slew costs a few hundred cone lookups whatever the size of the catalog
+    - A target that only grazes the edge of the cone between two samples (by less than about 1/500 of the half angle) can be missed
+*/
+
+class Fov_Query {
+
+private:
+
+    const Target_Catalog &catalog;  // targets to look for
+    std::vector<size_t> in_view;      // targets in the cone at the previous sample (index order)
+    std::vector<size_t> next_in_view; // targets in the cone at the current sample (index order)
+    std::vector<double> enter_times;  // s (entry time of each target in in_view)
+    std::vector<double> next_enter_times; // s (entry time of each target in next_in_view)
+
+    // how far a target is inside the cone t seconds into the slew (cosine of its angle from the boresight minus the cosine of the half angle, negative outside)
+    static double cone_margin(const Attitude &attitude, const Reorientation_Plan &plan, double t, double cos_half_angle, const double target[3]);
+
+    // time a target crosses the edge of the cone between two times, one in view and one not (false position)
+    static double find_crossing(const Attitude &attitude, const Reorientation_Plan &plan, double t_in, double t_out, double cos_half_angle, const double target[3]);
+
+public:
+
+    Fov_Query(const Target_Catalog &catalog); // constructor (the catalog must outlive the query and have its index built)
+
+    void find_passes(const Attitude &attitude, const Reorientation_Plan &plan, double half_angle, std::vector<Fov_Pass> &passes); // every pass of a catalog target through a field of view cone (half angle in rad) during the slew of a plan (attitude is the attitude the plan started from), replaces the contents of passes (in entry time order)
+
+};
+
+#endif
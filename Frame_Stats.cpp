@@ -0,0 +1,98 @@
+#include "Frame_Stats.hpp"
+
+#include <cmath>
+#include <cstring>
+
+// constructor (frame period the clock aims for)
+Frame_Stats::Frame_Stats(double target_period) {
+    this->target_period = target_period;
+    reset();
+}
+
+// forget every frame measured so far
+void Frame_Stats::reset() {
+    std::memset(frame_histogram , 0, sizeof(frame_histogram ));
+    std::memset(jitter_histogram, 0, sizeof(jitter_histogram));
+    frames          = 0;
+    missed          = 0;
+    overshoot_total = 0.0;
+    overshoot_max   = 0.0;
+    frame_time_max  = 0.0;
+}
+
+// add one frame (frame time, how late the sleep woke up, and whether the frame missed its deadline)
+void Frame_Stats::add(double frame_time, double overshoot, bool missed_deadline) {
+
+    // bin the frame time and its distance from the target period (anything past the end goes in the last bin)
+    int frame_bin  = static_cast<int>(frame_time / frame_bin_width);
+    int jitter_bin = static_cast<int>(std::fabs(frame_time - target_period) / jitter_bin_width);
+    frame_histogram [(frame_bin  < frame_bins ) ? frame_bin  : frame_bins  - 1]++;
+    jitter_histogram[(jitter_bin < jitter_bins) ? jitter_bin : jitter_bins - 1]++;
+
+    // running totals
+    frames++;
+    if (missed_deadline) {
+        missed++;
+    }
+    overshoot_total += overshoot;
+    if (overshoot > overshoot_max) {
+        overshoot_max = overshoot;
+    }
+    if (frame_time > frame_time_max) {
+        frame_time_max = frame_time;
+    }
+}
+
+// upper edge of the bin holding a fraction of the samples
+double Frame_Stats::percentile(const uint32_t *histogram, int bins, double bin_width, uint64_t count, double fraction) {
+
+    if (count == 0) {
+        return 0.0;
+    }
+
+    // walk the bins until the running count reaches the wanted rank
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count)));
+    uint64_t seen = 0;
+    for (int bin = 0; bin < bins; bin++) {
+        seen += histogram[bin];
+        if (seen >= rank && seen > 0) {
+            return (bin + 1) * bin_width;
+        }
+    }
+    return bins * bin_width;
+}
+
+// frames measured
+uint64_t Frame_Stats::get_frames() const {
+    return frames;
+}
+
+// frames that missed their deadline
+uint64_t Frame_Stats::get_missed() const {
+    return missed;
+}
+
+// s (frame time below which a fraction of the frames fall, e.g. 0.99)
+double Frame_Stats::frame_time_percentile(double fraction) const {
+    return percentile(frame_histogram, frame_bins, frame_bin_width, frames, fraction);
+}
+
+// s (jitter below which a fraction of the frames fall)
+double Frame_Stats::jitter_percentile(double fraction) const {
+    return percentile(jitter_histogram, jitter_bins, jitter_bin_width, frames, fraction);
+}
+
+// s (mean time sleeps woke up past their deadline)
+double Frame_Stats::get_mean_overshoot() const {
+    return (frames > 0) ? overshoot_total / static_cast<double>(frames) : 0.0;
+}
+
+// s (largest sleep overshoot)
+double Frame_Stats::get_max_overshoot() const {
+    return overshoot_max;
+}
+
+// s (longest frame)
+double Frame_Stats::get_max_frame_time() const {
+    return frame_time_max;
+}
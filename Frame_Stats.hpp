@@ -0,0 +1,60 @@
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include <cstdint>
+
+/* Frame pacing statistics of a realtime clock
+    - Frame times (wall clock time from one frame to the next) go into a histogram with 0.1 ms bins up to 100 ms,
+      jitter (distance of a frame time from the target frame period) into a histogram with 0.01 ms bins up to 10 ms
+    - Percentiles are read from the histograms, so they are accurate to one bin and adding a frame never allocates
+    - Longer frames and larger jitter land in the last bin
+*/
+
+class Frame_Stats {
+
+public:
+
+    static const int frame_bins  = 1000; // frame time histogram bins
+    static const int jitter_bins = 1000; // jitter histogram bins
+
+    static constexpr double frame_bin_width  = 1e-4; // s (frame time histogram bin width)
+    static constexpr double jitter_bin_width = 1e-5; // s (jitter histogram bin width)
+
+private:
+
+    double target_period;                // s (frame period the clock aims for)
+    uint32_t frame_histogram[frame_bins];   // frames per frame time bin
+    uint32_t jitter_histogram[jitter_bins]; // frames per jitter bin
+    uint64_t frames;                     // frames measured
+    uint64_t missed;                     // frames that were already past their deadline when they ended
+    double   overshoot_total;            // s (sum of the time sleeps woke up past their deadline)
+    double   overshoot_max;              // s (largest sleep overshoot)
+    double   frame_time_max;             // s (longest frame)
+
+    static double percentile(const uint32_t *histogram, int bins, double bin_width, uint64_t count, double fraction); // upper edge of the bin holding a fraction of the samples
+
+public:
+
+    Frame_Stats(double target_period); // constructor (frame period the clock aims for)
+
+    void reset(); // forget every frame measured so far
+
+    void add(double frame_time, double overshoot, bool missed_deadline); // add one frame (frame time, how late the sleep woke up, and whether the frame missed its deadline)
+
+    uint64_t get_frames() const; // frames measured
+
+    uint64_t get_missed() const; // frames that missed their deadline
+
+    double frame_time_percentile(double fraction) const; // s (frame time below which a fraction of the frames fall, e.g. 0.99)
+
+    double jitter_percentile(double fraction) const; // s (jitter below which a fraction of the frames fall)
+
+    double get_mean_overshoot() const; // s (mean time sleeps woke up past their deadline)
+
+    double get_max_overshoot() const; // s (largest sleep overshoot)
+
+    double get_max_frame_time() const; // s (longest frame)
+
+};
+
+#endif
@@ -1,7 +1,20 @@
 #include "Helper_Functions.hpp"
 
-// compute the smallest roll angle required to align target point for a single subsequent pitch or yaw maneuver
-void compute_efficient_roll(double local_phi, double &roll_angle, double &phi_offset, std::string &next_maneuver, int &next_sign) {
+#include <algorithm>
+
+// display name of a maneuver axis ("Roll", "Pitch", or "Yaw")
+const char *axis_name(Maneuver_Axis axis) {
+
+    switch (axis) {
+        case Maneuver_Axis::Roll : return "Roll";
+        case Maneuver_Axis::Pitch: return "Pitch";
+        case Maneuver_Axis::Yaw  : return "Yaw";
+    }
+    return "";
+}
+
+// compute the smallest roll angle required to align target point for a single subsequent pitch or yaw maneuver, returns false if local_phi is not a number (no roll is planned)
+bool compute_efficient_roll(double local_phi, double &roll_angle, double &phi_offset, Maneuver_Axis &next_maneuver, int &next_sign) {
 
     /* We need to determine the minimum amount of roll required to aligh the satellite such that a single
     pitch or yaw maneuver can be executed afterwards to finish aligning the satellite with the target point.
@@ -25,43 +38,47 @@ void compute_efficient_roll(double local_phi, double &roll_angle, double &phi_of
     */
 
     // define the roll angle and the next rotation to be applied to the satellite based on the local phi angle (minimizing magnitude of the roll angle)
-    if      (local_phi <=       M_PI / 4.0) {roll_angle = local_phi                   ; next_maneuver = "Yaw"  ; next_sign =  1;} // the positive x axis, positive phi side
-    else if (local_phi <= 3.0 * M_PI / 4.0) {roll_angle = local_phi -       M_PI / 2.0; next_maneuver = "Pitch"; next_sign = -1;} // the positive y axis
-    else if (local_phi <= 5.0 * M_PI / 4.0) {roll_angle = local_phi -       M_PI      ; next_maneuver = "Yaw"  ; next_sign = -1;} // the negative x axis
-    else if (local_phi <= 7.0 * M_PI / 4.0) {roll_angle = local_phi - 3.0 * M_PI / 2.0; next_maneuver = "Pitch"; next_sign =  1;} // the negative y axis
-    else if (local_phi >  7.0 * M_PI / 4.0) {roll_angle = local_phi - 2.0 * M_PI      ; next_maneuver = "Yaw"  ; next_sign =  1;} // the positive x axis, negative phi side
+    if      (local_phi <=       M_PI / 4.0) {roll_angle = local_phi                   ; next_maneuver = Maneuver_Axis::Yaw  ; next_sign =  1;} // the positive x axis, positive phi side
+    else if (local_phi <= 3.0 * M_PI / 4.0) {roll_angle = local_phi -       M_PI / 2.0; next_maneuver = Maneuver_Axis::Pitch; next_sign = -1;} // the positive y axis
+    else if (local_phi <= 5.0 * M_PI / 4.0) {roll_angle = local_phi -       M_PI      ; next_maneuver = Maneuver_Axis::Yaw  ; next_sign = -1;} // the negative x axis
+    else if (local_phi <= 7.0 * M_PI / 4.0) {roll_angle = local_phi - 3.0 * M_PI / 2.0; next_maneuver = Maneuver_Axis::Pitch; next_sign =  1;} // the negative y axis
+    else if (local_phi >  7.0 * M_PI / 4.0) {roll_angle = local_phi - 2.0 * M_PI      ; next_maneuver = Maneuver_Axis::Yaw  ; next_sign =  1;} // the positive x axis, negative phi side
     else {
-        
-        // something went wrong, exit program
-        std::cout << "ERROR: Invalid local_phi in Helper_Functions::compute_efficient_roll()" << std::endl; 
-        exit(1);
+
+        // only NaN fails every comparison, leave the satellite as it is and let the caller reject the target (this is also library code, see Planner_Api.h)
+        roll_angle    = 0.0;
+        phi_offset    = 0.0;
+        next_maneuver = Maneuver_Axis::Yaw;
+        next_sign     = 1;
+        return false;
     }
 
     // compute the phi offset so that the spherical coord math works out when using a more efficient maneuver instead of positive-yaw-only (i.e. instead of sweeping out spherical coordinate angles explicitly)
     phi_offset = local_phi - roll_angle;
 
+    return true;
 }
 
 // compute the rotation matrix for a given angle and rotation maneuver
-void compute_rotation_matrix(double rot_mat[3][3], double angle, const std::string axis) {
+void compute_rotation_matrix(double rot_mat[3][3], double angle, Maneuver_Axis axis) {
 
     // if the angle is negative, add 2pi to make it positive
     if (angle < 0.0) {angle += 2.0 * M_PI;}
 
     // define the rotation matrix based on the angle and rotation maneuver
-    if      (axis == "Pitch") {rot_mat[0][0] =         1.0; rot_mat[1][0] =         0.0; rot_mat[2][0] =         0.0;
-                               rot_mat[0][1] =         0.0; rot_mat[1][1] =  cos(angle); rot_mat[2][1] = -sin(angle);
-                               rot_mat[0][2] =         0.0; rot_mat[1][2] =  sin(angle); rot_mat[2][2] =  cos(angle);}
-    else if (axis == "Yaw"  ) {rot_mat[0][0] =  cos(angle); rot_mat[1][0] =         0.0; rot_mat[2][0] =  sin(angle);
-                               rot_mat[0][1] =         0.0; rot_mat[1][1] =         1.0; rot_mat[2][1] =         0.0;
-                               rot_mat[0][2] = -sin(angle); rot_mat[1][2] =         0.0; rot_mat[2][2] =  cos(angle);}
-    else if (axis == "Roll" ) {rot_mat[0][0] =  cos(angle); rot_mat[1][0] = -sin(angle); rot_mat[2][0] =         0.0;
-                               rot_mat[0][1] =  sin(angle); rot_mat[1][1] =  cos(angle); rot_mat[2][1] =         0.0;
-                               rot_mat[0][2] =         0.0; rot_mat[1][2] =         0.0; rot_mat[2][2] =         1.0;}
+    if      (axis == Maneuver_Axis::Pitch) {rot_mat[0][0] =         1.0; rot_mat[1][0] =         0.0; rot_mat[2][0] =         0.0;
+                                            rot_mat[0][1] =         0.0; rot_mat[1][1] =  cos(angle); rot_mat[2][1] = -sin(angle);
+                                            rot_mat[0][2] =         0.0; rot_mat[1][2] =  sin(angle); rot_mat[2][2] =  cos(angle);}
+    else if (axis == Maneuver_Axis::Yaw  ) {rot_mat[0][0] =  cos(angle); rot_mat[1][0] =         0.0; rot_mat[2][0] =  sin(angle);
+                                            rot_mat[0][1] =         0.0; rot_mat[1][1] =         1.0; rot_mat[2][1] =         0.0;
+                                            rot_mat[0][2] = -sin(angle); rot_mat[1][2] =         0.0; rot_mat[2][2] =  cos(angle);}
+    else if (axis == Maneuver_Axis::Roll ) {rot_mat[0][0] =  cos(angle); rot_mat[1][0] = -sin(angle); rot_mat[2][0] =         0.0;
+                                            rot_mat[0][1] =  sin(angle); rot_mat[1][1] =  cos(angle); rot_mat[2][1] =         0.0;
+                                            rot_mat[0][2] =         0.0; rot_mat[1][2] =         0.0; rot_mat[2][2] =         1.0;}
 }
 
 // multiply two rotation matrices
-void multiply_rot_mats(double rot_mat_1[3][3], double rot_mat_2[3][3], double rot_mat_out[3][3]) {
+void multiply_rot_mats(const double rot_mat_1[3][3], const double rot_mat_2[3][3], double rot_mat_out[3][3]) {
 
     // make sure rot_mat_out is initialized to zero (otherwise the += operation below will not work properly)
     for (int i = 0; i < 3; i++) {     // i represents row
@@ -81,7 +98,7 @@ void multiply_rot_mats(double rot_mat_1[3][3], double rot_mat_2[3][3], double ro
 }
 
 // copy a rotation matrix
-void copy_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]) {
+void copy_rot_mat(const double rot_mat_in[3][3], double rot_mat_out[3][3]) {
 
     // copy rot_mat_in to rot_mat_out
     for (int i = 0; i < 3; i++) {     // i represents row
@@ -92,7 +109,7 @@ void copy_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]) {
 }
 
 // transpose a rotation matrix
-void transpose_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]) {
+void transpose_rot_mat(const double rot_mat_in[3][3], double rot_mat_out[3][3]) {
 
     // transpose rot_mat_in and store in rot_mat_out
     for (int i = 0; i < 3; i++) {     // i represents row
@@ -103,7 +120,7 @@ void transpose_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]) {
 }
 
 // apply a rotation matrix to a set of coordinates
-void apply_rotation(double rot_mat[3][3], double &x, double &y, double &z) {
+void apply_rotation(const double rot_mat[3][3], double &x, double &y, double &z) {
 
     // create some temp variables to store the original values of x, y, and z
     double x_temp = x;
@@ -116,15 +133,153 @@ void apply_rotation(double rot_mat[3][3], double &x, double &y, double &z) {
     z = rot_mat[2][0] * x_temp + rot_mat[2][1] * y_temp + rot_mat[2][2] * z_temp;
 }
 
+// compute the rotation matrix that rotates coordinates by angle about a unit axis (right hand rule)
+void compute_axis_angle_matrix(double rot_mat[3][3], double axis_x, double axis_y, double axis_z, double angle) {
+
+    // Rodrigues' rotation formula in matrix form: R = cos*I + sin*[axis]x + (1 - cos)*axis*axis^T
+    double c = cos(angle);
+    double s = sin(angle);
+    double v = 1.0 - c;
+
+    rot_mat[0][0] = c + axis_x * axis_x * v         ; rot_mat[0][1] = axis_x * axis_y * v - axis_z * s; rot_mat[0][2] = axis_x * axis_z * v + axis_y * s;
+    rot_mat[1][0] = axis_y * axis_x * v + axis_z * s; rot_mat[1][1] = c + axis_y * axis_y * v         ; rot_mat[1][2] = axis_y * axis_z * v - axis_x * s;
+    rot_mat[2][0] = axis_z * axis_x * v - axis_y * s; rot_mat[2][1] = axis_z * axis_y * v + axis_x * s; rot_mat[2][2] = c + axis_z * axis_z * v         ;
+}
+
+// compute a time optimal accel/coast/decel profile for an angle given acceleration and angular velocity limits
+void compute_bang_coast_bang(double angle, double alpha_max, double omega_max, double &t_accel, double &t_coast, double &t_decel, double &alpha) {
+
+    /* Same profile as Reaction_Wheel::compute_maneuver, but for arbitrary limits (e.g. a rotation axis shared between several reaction wheels).
+       Accelerate at alpha_max until omega_max is reached, coast, then decelerate at alpha_max. Short maneuvers never reach omega_max and don't coast.
+    */
+
+    // handle condition when the angle is zero (no maneuver required)
+    if (angle == 0.0) {
+        t_accel = 0.0;
+        t_coast = 0.0;
+        t_decel = 0.0;
+        alpha   = 0.0;
+        return;
+    }
+
+    // compute the signed angular acceleration
+    double angle_abs = std::abs(angle);
+    alpha = alpha_max * (angle / angle_abs);
+
+    // time and angle needed to reach the max angular velocity
+    double t_full     = omega_max / alpha_max;
+    double theta_full = 0.5 * alpha_max * t_full * t_full;
+
+    if (angle_abs > (theta_full * 2)) {
+
+        // full acceleration and deceleration phases, coast at max angular velocity for the remaining angle
+        t_accel = t_full;
+        t_decel = t_full;
+        t_coast = (angle_abs - theta_full * 2) / omega_max;
+    }
+    else {
+
+        // partial, but still equal, acceleration and deceleration phases are required
+        t_accel = sqrt(angle_abs / alpha_max);
+        t_decel = t_accel;
+        t_coast = 0.0;
+    }
+}
+
+// compute the accel/coast/decel profile that covers an angle in exactly the given duration with the lowest peak angular velocity
+void compute_timed_bang_coast_bang(double angle, double duration, double alpha_max, double omega_max, double &t_accel, double &t_coast, double &t_decel, double &alpha) {
+
+    /* Used when a maneuver doesn't need to finish as soon as possible (e.g. it runs alongside a longer one).
+       Accelerating at alpha_max to a lower coasting velocity omega finishes in duration T when
+           angle = omega * (T - omega / alpha_max)   ->   omega = (alpha_max * T - sqrt(alpha_max^2 * T^2 - 4 * alpha_max * angle)) / 2
+       which keeps the reaction wheel as far from saturation as possible for that duration.
+    */
+
+    // start from the time optimal profile
+    compute_bang_coast_bang(angle, alpha_max, omega_max, t_accel, t_coast, t_decel, alpha);
+
+    // nothing to stretch if there is no maneuver, or the duration isn't longer than the time optimal profile
+    double angle_abs = std::abs(angle);
+    if (angle == 0.0 || duration <= t_accel + t_coast + t_decel) {
+        return;
+    }
+
+    // solve for the lowest coasting velocity that still finishes in time
+    double discriminant = alpha_max * alpha_max * duration * duration - 4.0 * alpha_max * angle_abs;
+    double omega        = 0.5 * (alpha_max * duration - sqrt(std::max(0.0, discriminant)));
+
+    t_accel = omega / alpha_max;
+    t_decel = t_accel;
+    t_coast = duration - 2.0 * t_accel;
+}
+
+// cut an accel/coast/decel profile short so it starts decelerating at time t (unchanged if it already is, zero if it hasn't started)
+void brake_bang_coast_bang(double t, double &t_accel, double &t_coast, double &t_decel) {
+
+    /* Braking at the same acceleration the profile spun up with takes as long as the spin up did, so the cut profile is still
+       an ordinary accel/coast/decel profile and evaluate_bang_coast_bang gives the same angle and angular velocity up to time t.
+    */
+
+    if (t <= 0.0) { // not started, nothing to brake
+
+        t_accel = 0.0;
+        t_coast = 0.0;
+        t_decel = 0.0;
+
+    } else if (t < t_accel) { // accelerating, decelerate for as long as it accelerated
+
+        t_accel = t;
+        t_coast = 0.0;
+        t_decel = t;
+
+    } else if (t < t_accel + t_coast) { // coasting, decelerate right away
+
+        t_coast = t - t_accel;
+        t_decel = t_accel;
+    }
+}
+
+// angle turned and angular velocity at time t into an accel/coast/decel profile
+void evaluate_bang_coast_bang(double t, double alpha, double t_accel, double t_coast, double t_decel, double &angle, double &omega) {
+
+    if (t <= 0.0) { // not started
+
+        angle = 0.0;
+        omega = 0.0;
+
+    } else if (t < t_accel) { // accelerating
+
+        angle = alpha * t * t / 2.0;
+        omega = alpha * t;
+
+    } else if (t < t_accel + t_coast) { // coasting
+
+        double t_in_phase = t - t_accel;
+        omega = alpha * t_accel;
+        angle = alpha * t_accel * t_accel / 2.0 + omega * t_in_phase;
+
+    } else if (t < t_accel + t_coast + t_decel) { // decelerating
+
+        double t_in_phase = t - t_accel - t_coast;
+        omega = alpha * t_accel - alpha * t_in_phase;
+        angle = (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_in_phase - alpha * t_in_phase * t_in_phase / 2.0);
+
+    } else { // complete
+
+        omega = alpha * t_accel - alpha * t_decel;
+        angle = (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_decel - alpha * t_decel * t_decel / 2.0);
+    }
+}
+
 // determine which planet is in the satellite's current focused octant
-void determine_focused_planet(double x, double y, double z, std::string &planet) {
+void determine_focused_planet(double x, double y, double z, const char *&planet) {
 
     // Round the coordinates to the nearest 2nd decimal place (avoids misidentification due to floating-point error)
     double rounded_x = std::round(x * 100) / 100; x = rounded_x;
     double rounded_y = std::round(y * 100) / 100; y = rounded_y;
     double rounded_z = std::round(z * 100) / 100; z = rounded_z;
 
-    // determine which planet is in the satellite's current focused octant
+    // determine which planet is in the satellite's current focused octant (static strings, nothing is allocated)
     if      (x > 0.0 && y > 0.0 && z > 0.0) {planet = "GRACE (+x, +y, +z)";}
     else if (x > 0.0 && y < 0.0 && z > 0.0) {planet =  "BRAY (+x, -y, +z)";}
     else if (x > 0.0 && y > 0.0 && z < 0.0) {planet = "PRICE (+x, +y, -z)";}
@@ -5,18 +5,37 @@
 #include <iostream>
 #include <cmath>
 
-void compute_efficient_roll(double local_phi, double &roll_angle, double &phi_offset, std::string &next_maneuver, int &next_sign); // compute the smallest roll angle required to align target point for a single subsequent pitch or yaw maneuver
+// satellite rotation maneuver axes (see compute_efficient_roll for the axis convention)
+enum class Maneuver_Axis {
+    Roll,  // rotation about +z axis
+    Pitch, // rotation about +x axis
+    Yaw    // rotation about +y axis
+};
 
-void compute_rotation_matrix(double rot_mat[3][3], double angle, const std::string axis); // compute the rotation matrix for a given angle and rotation maneuver
+const char *axis_name(Maneuver_Axis axis); // display name of a maneuver axis ("Roll", "Pitch", or "Yaw")
 
-void multiply_rot_mats(double rot_mat_1[3][3], double rot_mat_2[3][3], double rot_mat_out[3][3]); // multiply two rotation matrices
+bool compute_efficient_roll(double local_phi, double &roll_angle, double &phi_offset, Maneuver_Axis &next_maneuver, int &next_sign); // compute the smallest roll angle required to align target point for a single subsequent pitch or yaw maneuver, returns false if local_phi is not a number (no roll is planned)
 
-void copy_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]); // copy a rotation matrix
+void compute_rotation_matrix(double rot_mat[3][3], double angle, Maneuver_Axis axis); // compute the rotation matrix for a given angle and rotation maneuver
 
-void transpose_rot_mat(double rot_mat_in[3][3], double rot_mat_out[3][3]); // transpose a rotation matrix
+void multiply_rot_mats(const double rot_mat_1[3][3], const double rot_mat_2[3][3], double rot_mat_out[3][3]); // multiply two rotation matrices
 
-void apply_rotation(double rot_mat[3][3], double &x, double &y, double &z); // apply a rotation matrix to a set of coordinates
+void copy_rot_mat(const double rot_mat_in[3][3], double rot_mat_out[3][3]); // copy a rotation matrix
 
-void determine_focused_planet(double x, double y, double z, std::string &planet); // determine which planet is in the satellite's current focused octant
+void transpose_rot_mat(const double rot_mat_in[3][3], double rot_mat_out[3][3]); // transpose a rotation matrix
+
+void apply_rotation(const double rot_mat[3][3], double &x, double &y, double &z); // apply a rotation matrix to a set of coordinates
+
+void compute_axis_angle_matrix(double rot_mat[3][3], double axis_x, double axis_y, double axis_z, double angle); // compute the rotation matrix that rotates coordinates by angle about a unit axis (right hand rule)
+
+void compute_bang_coast_bang(double angle, double alpha_max, double omega_max, double &t_accel, double &t_coast, double &t_decel, double &alpha); // compute a time optimal accel/coast/decel profile for an angle given acceleration and angular velocity limits
+
+void compute_timed_bang_coast_bang(double angle, double duration, double alpha_max, double omega_max, double &t_accel, double &t_coast, double &t_decel, double &alpha); // compute the accel/coast/decel profile that covers an angle in exactly the given duration with the lowest peak angular velocity
+
+void evaluate_bang_coast_bang(double t, double alpha, double t_accel, double t_coast, double t_decel, double &angle, double &omega); // angle turned and angular velocity at time t into an accel/coast/decel profile
+
+void brake_bang_coast_bang(double t, double &t_accel, double &t_coast, double &t_decel); // cut an accel/coast/decel profile short so it starts decelerating at time t (unchanged if it already is, zero if it hasn't started)
+
+void determine_focused_planet(double x, double y, double z, const char *&planet); // determine which planet is in the satellite's current focused octant
 
 #endif
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Ideal_Cube_Sat.hpp"
+#include "Command_Server.hpp"
+#include <algorithm>
 
 /* Assumptions:
     - The satellite is a perfect cube with uniform mass distribution (equation for a cube is used to compute inertia)
@@ -7,31 +9,63 @@
 */
 
 // define constructor
-Ideal_Cube_Sat::Ideal_Cube_Sat(): // member variables that are external classes which take arguments must be initialized in the initializer list otherwise they will be initialized with default constructor first anyway (just how C++ works)
+Ideal_Cube_Sat::Ideal_Cube_Sat(Clock_Mode clock_mode, double time_scale, bool headless, const Satellite_Config &config): // member variables that are external classes which take arguments must be initialized in the initializer list otherwise they will be initialized with default constructor first anyway (just how C++ works)
 
-    // initialize satellite properties
-    mass(16.0), 
-    size(0.2),
-    inertia(mass * (size * size) / 6.0),
+    // initialize the max frames per second of console refresh (needed here since the simulation clock paces frames with it)
+    FPS(60.0),
+
+    // initialize satellite properties (16 kg, 0.2 m cube unless configured otherwise)
+    mass(config.mass),
+    size(config.size),
+    inertia(config.get_inertia()),
+
+    // initialize the simulation clock (one frame per console refresh)
+    sim_clock(clock_mode, time_scale, FPS),
+
+    // initialize the console manager object
+    console_man(),
+
+    // initialize the renderer (draws at the console refresh rate)
+    renderer(console_man, FPS),
 
     // initialize the reaction wheels (same specification for all 3 axes)
-    reaction_wheel_roll( inertia), 
-    reaction_wheel_pitch(inertia), 
-    reaction_wheel_yaw(  inertia), 
+    reaction_wheel_roll( inertia, config.max_torque, config.max_angular_momentum),
+    reaction_wheel_pitch(inertia, config.max_torque, config.max_angular_momentum),
+    reaction_wheel_yaw(  inertia, config.max_torque, config.max_angular_momentum),
 
     // initialize the current point at default starting location (global cartesian coords)
     curr_point(0.0, 0.0, 1.0), 
 
     // initialize the target point at default starting location (global cartesian coords)
-    targ_point(0.0, 0.0, 1.0),
-
-    // initialize the console manager object
-    console_man()
+    targ_point(0.0, 0.0, 1.0)
 
 { // now can initialize member variables that are not external classes with arguments
 
-    // initialize the max frames per second of console refresh
-    FPS = 60.0;
+    // initialize the output mode (headless runs have nobody to read the start and end messages, so they are not held on screen)
+    this->headless  = headless;
+    display_padding = headless ? 0.0 : 1.0;
+
+    // the console is drawn from its own thread, so slow terminal output never stretches the physics frames
+    frame    = 0;
+    recorder = nullptr;
+    server   = nullptr;
+    catalog  = nullptr;
+    headless_snapshot = Satellite_Snapshot();
+
+    // nobody can retarget the satellite mid-maneuver until a command queue is set
+    commands           = nullptr;
+    preempted          = false;
+    preempt_time       = 0.0;
+    has_pending_target = false;
+    pending_target[0] = 0.0; pending_target[1] = 0.0; pending_target[2] = 0.0;
+    quit_requested     = false;
+    if (!headless) {
+        renderer.start();
+    }
+
+    // initialize the slew planner (roll then pitch or yaw, the original behavior)
+    planner_mode = Planner_Mode::Roll_Then_Tilt;
+    eigen_axis[0] = 0.0; eigen_axis[1] = 0.0; eigen_axis[2] = 0.0;
 
     // initialize satellite current rotational motion state
     omega_roll  = 0.0;
@@ -39,125 +73,333 @@ Ideal_Cube_Sat::Ideal_Cube_Sat(): // member variables that are external classes
     omega_yaw   = 0.0;
 
     // initialize satellite zoom rate
-    zoom_rate = 1.5;
-
-    // initialize the default rotation matrix (starts out as identity matrix - the same reference frame as global coordinate system)
-    rot_mat[0][0] = 1.0; rot_mat[1][0] = 0.0; rot_mat[2][0] = 0.0;
-    rot_mat[0][1] = 0.0; rot_mat[1][1] = 1.0; rot_mat[2][1] = 0.0;
-    rot_mat[0][2] = 0.0; rot_mat[1][2] = 0.0; rot_mat[2][2] = 1.0;
+    zoom_rate = config.zoom_rate;
 
-    // initialize the default transposed rotation matrix (starts out as identity matrix - the same reference frame as global coordinate system)
-    rot_mat_T[0][0] = 1.0; rot_mat_T[1][0] = 0.0; rot_mat_T[2][0] = 0.0;
-    rot_mat_T[0][1] = 0.0; rot_mat_T[1][1] = 1.0; rot_mat_T[2][1] = 0.0;
-    rot_mat_T[0][2] = 0.0; rot_mat_T[1][2] = 0.0; rot_mat_T[2][2] = 1.0;
+    // initialize the default attitude (starts out as identity - the same reference frame as global coordinate system)
+    attitude = Attitude();
 }
 
- // prints current satellite info to the console
-void Ideal_Cube_Sat::print_info(std::string message) {
-
-    // update the console output
-    console_man.update(targ_point.global_x           , targ_point.global_y            , targ_point.global_z          , 
-                       curr_point.global_x           , curr_point.global_y            , curr_point.global_z          , 
-                       targ_point.local_x            , targ_point.local_y             , targ_point.local_z           , 
-                       curr_point.local_x            , curr_point.local_y             , curr_point.local_z           , 
-                       targ_point.local_r            , targ_point.local_theta         , targ_point.local_phi         ,
-                       curr_point.local_r            , curr_point.local_theta         , curr_point.local_phi         ,
-                       rot_mat                       , rot_mat_T                      ,
-                       omega_roll                    , omega_pitch                    , omega_yaw                    , 
-                       reaction_wheel_roll.saturation, reaction_wheel_pitch.saturation, reaction_wheel_yaw.saturation, 
-                       curr_point.local_r            , message);
+// publishes current satellite info for the console and the telemetry recorder (never waits for either)
+void Ideal_Cube_Sat::print_info(Status_Message message) {
+
+    // nothing is displayed, recorded, or streamed in headless mode without a recorder or a subscribed client
+    bool streaming = (server != nullptr && server->is_streaming());
+    if (headless && recorder == nullptr && !streaming) {
+        return;
+    }
+
+    // fill in the snapshot (plain copies, the render thread only ever sees complete snapshots)
+    Satellite_Snapshot &snapshot = headless ? headless_snapshot : renderer.snapshot();
+    snapshot.frame             = frame++;
+    snapshot.sim_time          = sim_clock.session_time();
+    snapshot.targ_global[0]    = targ_point.global_x;  snapshot.targ_global[1]    = targ_point.global_y;     snapshot.targ_global[2]    = targ_point.global_z;
+    snapshot.curr_global[0]    = curr_point.global_x;  snapshot.curr_global[1]    = curr_point.global_y;     snapshot.curr_global[2]    = curr_point.global_z;
+    snapshot.targ_local[0]     = targ_point.local_x;   snapshot.targ_local[1]     = targ_point.local_y;      snapshot.targ_local[2]     = targ_point.local_z;
+    snapshot.curr_local[0]     = curr_point.local_x;   snapshot.curr_local[1]     = curr_point.local_y;      snapshot.curr_local[2]     = curr_point.local_z;
+    snapshot.targ_spherical[0] = targ_point.local_r;   snapshot.targ_spherical[1] = targ_point.local_theta;  snapshot.targ_spherical[2] = targ_point.local_phi;
+    snapshot.curr_spherical[0] = curr_point.local_r;   snapshot.curr_spherical[1] = curr_point.local_theta;  snapshot.curr_spherical[2] = curr_point.local_phi;
+    snapshot.attitude          = attitude;
+    snapshot.omega_roll        = omega_roll;
+    snapshot.omega_pitch       = omega_pitch;
+    snapshot.omega_yaw         = omega_yaw;
+    snapshot.saturation_roll   = reaction_wheel_roll.saturation;
+    snapshot.saturation_pitch  = reaction_wheel_pitch.saturation;
+    snapshot.saturation_yaw    = reaction_wheel_yaw.saturation;
+    snapshot.zoom_dist         = curr_point.local_r;
+    const Frame_Stats &stats   = sim_clock.get_frame_stats();
+    snapshot.frame_time        = sim_clock.get_last_frame_time();
+    snapshot.sleep_overshoot   = sim_clock.get_last_overshoot();
+    snapshot.missed_deadline   = sim_clock.get_last_missed();
+    snapshot.frame_p50         = stats.frame_time_percentile(0.5);
+    snapshot.frame_p99         = stats.frame_time_percentile(0.99);
+    snapshot.jitter_p99        = stats.jitter_percentile(0.99);
+    snapshot.overshoot_max     = stats.get_max_overshoot();
+    snapshot.frames_timed      = stats.get_frames();
+    snapshot.frames_missed     = stats.get_missed();
+    snapshot.status            = message;
+    if (!headless) {
+        std::snprintf(snapshot.message, sizeof(snapshot.message), "%s", status_text(message)); // (telemetry only stores the code)
+    }
+
+    // nearest catalog target to where the satellite is looking (only the dashboard shows it)
+    size_t target_index;
+    if (!headless && catalog != nullptr && catalog->nearest(curr_point.global_x, curr_point.global_y, curr_point.global_z, target_index, snapshot.catalog_angle)) {
+        std::snprintf(snapshot.catalog_name, sizeof(snapshot.catalog_name), "%s", catalog->get_name(target_index));
+    } else {
+        snapshot.catalog_name[0] = '\0';
+        snapshot.catalog_angle   = 0.0;
+    }
 
+    // write it to the telemetry file
+    if (recorder != nullptr) {
+        recorder->record(snapshot);
+    }
+
+    // queue it to the server's subscribers
+    if (streaming) {
+        server->stream(snapshot);
+    }
+
+    // hand it to the render thread
+    if (!headless) {
+        renderer.publish();
+    }
 }
 
-// get user input for new target point
-void Ideal_Cube_Sat::get_new_target() {
+// get user input for new target point, returns false if the user quit
+bool Ideal_Cube_Sat::get_new_target() {
+
+    // the input thread owns standard input, so targets can only come through its queue
+    if (commands == nullptr) {
+        std::cerr << "ERROR: No command queue to read the new target from" << std::endl;
+        return false;
+    }
+
+    // "quit" typed mid-maneuver
+    if (quit_requested) {
+        return false;
+    }
 
     // declare new user input values
     double new_x, new_y, new_z;
 
-    // use console manager to get new target point from user
-    console_man.get_new_target(new_x, new_y, new_z);
+    // use console manager to get new target point from user (the renderer first draws the latest state, then leaves the console alone)
+    renderer.pause();
+    bool valid = console_man.get_new_target(*commands, new_x, new_y, new_z);
+    renderer.resume();
+    if (!valid) {
+        quit_requested = true;
+        return false;
+    }
     
     // redifine target point based on the new user coordinates
     targ_point = Location(new_x, new_y, new_z);
+
+    return true;
+}
+
+// target typed during the last reorientation (global cartesian coords), returns false if there is none
+bool Ideal_Cube_Sat::take_pending_target(double &x, double &y, double &z) {
+
+    if (!has_pending_target || quit_requested) {
+        return false;
+    }
+    x = pending_target[0];
+    y = pending_target[1];
+    z = pending_target[2];
+    has_pending_target = false;
+    return true;
+}
+
+// take the command lines typed since the last frame (a valid target or "quit" cuts the current reorientation short)
+void Ideal_Cube_Sat::poll_commands() {
+
+    if (commands == nullptr) {
+        return;
+    }
+
+    double x, y, z;
+    while (commands->poll(command_line)) {
+
+        // the typed line (and its echo) scrolled the terminal under the dashboard
+        renderer.redraw();
+
+        if (command_line == "quit") {
+            quit_requested = true;
+            preempted      = true;
+        } else if (Console_Manager::parse_target(command_line, x, y, z) && !(x == 0.0 && y == 0.0 && z == 0.0)) {
+            pending_target[0]  = x;
+            pending_target[1]  = y;
+            pending_target[2]  = z;
+            has_pending_target = true;
+            preempted          = true;
+        }
+        // (anything else is ignored, there is no prompt to answer mid-maneuver)
+    }
+}
+
+// set a new target point directly (global cartesian coords), returns false if the point is not valid
+bool Ideal_Cube_Sat::set_target(double x, double y, double z) {
+
+    // the origin and non-finite points have no direction, so they can't be pointed at (same rule as console input)
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z) || (x == 0.0 && y == 0.0 && z == 0.0)) {
+        return false;
+    }
+
+    // redifine target point based on the new coordinates
+    targ_point = Location(x, y, z);
+
+    return true;
 }
 
 // perform sequence of attitude maneuvers to reorient sattelite to target point
 void Ideal_Cube_Sat::reorient() {
 
-    // convert the target point's global coords to local coords by applying the satellite's current rotation matrix
-    targ_point.compute_local_coords(rot_mat);
-    
-    double roll_angle = 0.0;   // roll angle to be applied to the satellite
-    double phi_offset = 0.0;   // offset to the roll angle for spherical coordinate math when using a more efficient maneuver sequence (i.e. not rolling full phi angle and using something else other than a positive yaw maneuver next)
-    std::string next_maneuver; // string label of next rotation maneuver needed after roll maneuver
-    int next_sign;             // sign convention of next rotation maneuver
+    // run every frame of the reorientation on this thread
+    Maneuver_Task task = reorient_task();
+    while (task.resume()) {
+    }
+}
+
+// reorient() one physics frame per resume() (for interleaving many satellites, see Satellite_Scheduler)
+Maneuver_Task Ideal_Cube_Sat::reorient_task() {
+
+    // convert the target point's global coords to local coords by applying the satellite's current attitude (for console display)
+    targ_point.compute_local_coords(attitude);
+
+    // plan the whole reorientation up front (roll angle, subsequent pitch or yaw maneuver, and all phase times)
+    Reorientation_Plan plan;
+    plan_reorientation(targ_point.global_x, targ_point.global_y, targ_point.global_z, plan);
 
-    // compute the most efficient roll angle and the subsequent rotation maneuver
-    compute_efficient_roll(targ_point.local_phi, roll_angle, phi_offset, next_maneuver, next_sign);
+    // start a fresh metrics summary for this reorientation
+    last_metrics = Reorient_Metrics();
+    last_metrics.plan = plan;
 
-    // compute the time required to complete the roll maneuver and the angular acceleration during accel/decel phases
-    double t_accel, t_coast, t_decel, alpha;
-    reaction_wheel_roll.compute_maneuver(roll_angle, t_accel, t_coast, t_decel, alpha);
+    // nothing has cut this reorientation short yet (slew_offset is when the maneuver in progress started, in slew time)
+    preempted = false;
+    double slew_offset = 0.0;
 
-    // execute the roll maneuver
-    execute_maneuver("Roll", 1, "phi", roll_angle, phi_offset, omega_roll, alpha, t_accel, t_coast, t_decel);
+    if (plan.mode == Planner_Mode::Eigen_Axis) {
 
-    // check if the next maneuver is Pitch or Yaw
-    if (next_maneuver == "Pitch") {
+        // point the focus point's phi straight at the target (the focus point sits on the boresight, so this doesn't move it)
+        curr_point.update_local_spherical<Spherical_Coord::Phi>(plan.target_phi);
 
-        // compute maneuver parameters and exectue
-        reaction_wheel_pitch.compute_maneuver(targ_point.local_theta, t_accel, t_coast, t_decel, alpha);
-        execute_maneuver(next_maneuver, next_sign, "theta", targ_point.local_theta, 0, omega_pitch, alpha, t_accel, t_coast, t_decel);
+        // execute the single eigen-axis maneuver (sweeps theta along the great circle to the target)
+        double omega_eigen = 0.0;
+        // (share of the rotation each wheel carries)
+        eigen_axis[0] = plan.eigen_axis[0];
+        eigen_axis[1] = plan.eigen_axis[1];
+        eigen_axis[2] = plan.eigen_axis[2];
+        Maneuver_Task maneuver = execute_maneuver<Maneuver_Type::Eigen_Axis, Spherical_Coord::Theta>(1, 0, omega_eigen, plan.eigen_alpha, plan.eigen_t_accel, plan.eigen_t_coast, plan.eigen_t_decel);
+        while (maneuver.resume()) {
+            co_yield maneuver.status();
+        }
+
+    } else if (plan.mode == Planner_Mode::Concurrent) {
+
+        // execute the roll, pitch or yaw, and zoom all at once
+        Maneuver_Task maneuver = execute_concurrent(plan);
+        while (maneuver.resume()) {
+            co_yield maneuver.status();
+        }
+
+    } else {
+
+        // execute the roll maneuver
+        Maneuver_Task maneuver = execute_maneuver<Maneuver_Type::Roll, Spherical_Coord::Phi>(1, plan.phi_offset, omega_roll, plan.roll_alpha, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel);
+        while (maneuver.resume()) {
+            co_yield maneuver.status();
+        }
+
+        // execute the pitch or yaw maneuver (skipped if a new target arrived during the roll)
+        if (!preempted) {
+            slew_offset = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel;
+            if (plan.tilt_axis == Maneuver_Axis::Pitch) {
+                maneuver = execute_maneuver<Maneuver_Type::Pitch, Spherical_Coord::Theta>(plan.tilt_sign, 0, omega_pitch, plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel);
+            } else {
+                maneuver = execute_maneuver<Maneuver_Type::Yaw  , Spherical_Coord::Theta>(plan.tilt_sign, 0, omega_yaw  , plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel);
+            }
+            while (maneuver.resume()) {
+                co_yield maneuver.status();
+            }
+        }
     }
 
-    else if (next_maneuver == "Yaw") {
+    // adjust the satellite's zoom level (already done during a concurrent slew, skipped if a new target arrived during the slew)
+    if (plan.mode != Planner_Mode::Concurrent && !preempted) {
+        slew_offset = plan.slew_time;
+        Maneuver_Task zoom = adjust_zoom();
+        while (zoom.resume()) {
+            co_yield zoom.status();
+        }
+    }
 
-        // compute maneuver parameters and exectue
-        reaction_wheel_yaw.compute_maneuver(targ_point.local_theta, t_accel, t_coast, t_decel, alpha);
-        execute_maneuver(next_maneuver, next_sign, "theta", targ_point.local_theta, 0, omega_yaw, alpha, t_accel, t_coast, t_decel);
+    // a new target cut the reorientation short: the satellite came to rest wherever the braked profiles left it
+    if (preempted) {
+        ::brake_plan(attitude, slew_offset + preempt_time, plan);
+        last_metrics.plan = plan;
     }
 
-    else {
+    // update the satellite's current attitude to the planned final attitude
+    attitude = plan.final_attitude;
 
-        // something went wrong, exit program
-        std::cout << "ERROR: Invalid next maneuver in Ideal_Cube_Sat::reorient()" << std::endl;
-        exit(1);
+    // update the satellite's current point and target point after completing maneuvers (a target that was never reached keeps its offset from the focus point)
+    curr_point.rotate_local_coords();
+    if (preempted) {
+        targ_point.compute_local_coords(attitude);
+    } else {
+        targ_point.rotate_local_coords();
     }
 
-    // adjust the satellite's zoom level
-    adjust_zoom();
+    // compute the final pointing error (angle between the focus point and target point directions, clamped against floating-point error)
+    double dot = curr_point.global_x * targ_point.global_x + curr_point.global_y * targ_point.global_y + curr_point.global_z * targ_point.global_z;
+    double cos_error = dot / (curr_point.local_r * targ_point.local_r);
+    last_metrics.pointing_error = acos(std::max(-1.0, std::min(1.0, cos_error)));
+}
 
-    // initialize some temp rotation matrices
-    double maneuver_rot_mat[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0 ,0.0, 0.0}};
-    double rot_mat_temp[3][3]     = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0 ,0.0, 0.0}};
-    double rot_mat_T_temp[3][3]   = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0 ,0.0, 0.0}};
+// plan a reorientation from the current attitude to a target point (global cartesian coords) without executing it
+void Ideal_Cube_Sat::plan_reorientation(double x, double y, double z, Reorientation_Plan &plan) {
 
-    // compute the rotation matrix of the first maneuver
-    compute_rotation_matrix(maneuver_rot_mat, roll_angle, "Roll");
+    // use the closed form planner with this satellite's current attitude and hardware
+    ::plan_reorientation(attitude, curr_point.local_r, x, y, z, reaction_wheel_roll, reaction_wheel_pitch, reaction_wheel_yaw, zoom_rate, plan, planner_mode);
+}
 
-    // update the satellite's current rotation matrix
-    multiply_rot_mats(maneuver_rot_mat, rot_mat, rot_mat_temp);
-    copy_rot_mat(rot_mat_temp, rot_mat);
+// current attitude (global to local cartesian coords)
+const Attitude &Ideal_Cube_Sat::get_attitude() {
+    return attitude;
+}
 
-    // compute the rotation matrix of the second maneuver
-    compute_rotation_matrix(maneuver_rot_mat, next_sign * targ_point.local_theta, next_maneuver);
+// derive the current rotation matrix (global to local cartesian coords)
+void Ideal_Cube_Sat::get_rot_mat(double rot_mat_out[3][3]) {
+    attitude.to_rot_mat(rot_mat_out);
+}
 
-    // update the satellite's current rotation matrix
-    multiply_rot_mats(maneuver_rot_mat, rot_mat, rot_mat_temp);
-    copy_rot_mat(rot_mat_temp, rot_mat);
+// optical zoom rate (coordinate units/s)
+double Ideal_Cube_Sat::get_zoom_rate() {
+    return zoom_rate;
+}
 
-    // update the satellite's current rotation matrix transpose
-    transpose_rot_mat(rot_mat, rot_mat_T_temp);
-    copy_rot_mat(rot_mat_T_temp, rot_mat_T);
+// s (physics frame period)
+double Ideal_Cube_Sat::get_frame_period() {
+    return 1.0 / FPS;
+}
 
-    // update the satellite's current point and target point after completing maneuvers
-    curr_point.rotate_local_coords();
-    targ_point.rotate_local_coords();
+// record every frame from now on (nullptr stops recording)
+void Ideal_Cube_Sat::set_recorder(Telemetry_Recorder *recorder) {
+    this->recorder = recorder;
+    if (recorder != nullptr) {
+        recorder->set_frame_period(1.0 / FPS);
+    }
+}
+
+// stream every frame to the subscribers of a command server from now on (nullptr stops streaming)
+void Ideal_Cube_Sat::set_server(Command_Server *server) {
+    this->server = server;
+}
+
+// show the nearest target of a catalog on the dashboard from now on (nullptr shows the planet octant, the catalog must outlive the satellite)
+void Ideal_Cube_Sat::set_catalog(const Target_Catalog *catalog) {
+    this->catalog = catalog;
 }
 
-// execute a single rotation maneuver
-void Ideal_Cube_Sat::execute_maneuver(std::string maneuver, int sign, std::string coord, double angle, double offset, double &omega, double alpha, double t_accel, double t_coast, double t_decel) {
+// watch for new targets typed mid-maneuver from now on, and read targets from it between maneuvers (the queue must outlive the satellite)
+void Ideal_Cube_Sat::set_command_queue(Command_Queue *commands) {
+    this->commands = commands;
+}
+
+// select how reorient() slews to a new target
+void Ideal_Cube_Sat::set_planner_mode(Planner_Mode mode) {
+    planner_mode = mode;
+}
+
+// how reorient() slews to a new target
+Planner_Mode Ideal_Cube_Sat::get_planner_mode() {
+    return planner_mode;
+}
+
+// execute a single rotation maneuver (the maneuver and the coordinate it moves are fixed at compile time)
+template <Maneuver_Type maneuver, Spherical_Coord coord>
+Maneuver_Task Ideal_Cube_Sat::execute_maneuver(int sign, double offset, double &omega, double alpha, double t_accel, double t_coast, double t_decel) {
     
     /* Note: sign is only used for non-roll maneuvers. 
        In polar coordinates, theta angle is always positive, but depending on orientation of satellite, may need a negative Pitch or Yaw maneuver to achieve the change in theta angle. 
@@ -165,104 +407,230 @@ void Ideal_Cube_Sat::execute_maneuver(std::string maneuver, int sign, std::strin
     */
 
     // initialize loop variables
-    auto   t_start    = std::chrono::high_resolution_clock::now(); // get current time
-    double t_elapsed  = 0.0;                                       // initialize elapsed time
-    double t_in_phase = 0.0;                                       // initialize time in current phase of maneuver
-    bool   startup    = true;                                      // initialize startup flag
-    std::string message;                                           // initialize custom message to be displayed in console
-
-    // simulate the realtime motion of the satellite during the maneuver (add 1s to display initial starting message and 1s to display final message after maneuver is complete)
-    while (t_elapsed < (t_accel + t_coast + t_decel + 2.0)) {
+    double t_elapsed  = 0.0;             // initialize elapsed time
+    double t_in_phase = 0.0;             // initialize time in current phase of maneuver
+    double t_pad      = display_padding; // time to hold the start and end messages on screen
+    double t_stop     = t_accel + t_coast + t_decel + 2.0 * t_pad; // time the last frame starts at or after (sooner if a new target arrives)
+    bool   startup    = true;            // initialize startup flag
+    Status_Message message;              // initialize message to be displayed in console
+
+    // start the simulation clock for this maneuver
+    sim_clock.start();
+
+    // simulate the motion of the satellite during the maneuver (add padding to display initial starting message and final message after maneuver is complete)
+    // (always runs at least one frame so the final state is applied even for zero length maneuvers without padding)
+    do {
         
-        // get current time and compute elapsed time
-        auto t_now = std::chrono::high_resolution_clock::now();
-        t_elapsed  = std::chrono::duration<double>(t_now - t_start).count();
+        // get elapsed simulation time
+        t_elapsed = sim_clock.elapsed();
+
+        // a new target cuts the maneuver short: brake right away from the current rate and don't hold the end message
+        if (!preempted) {
+            poll_commands();
+            if (preempted) {
+                preempt_time = std::clamp(t_elapsed - t_pad, 0.0, t_accel + t_coast + t_decel); // (during the start padding this maneuver hasn't moved yet, the ones before it are done)
+                brake_bang_coast_bang(t_elapsed - t_pad, t_accel, t_coast, t_decel);
+                t_stop = (t_elapsed < t_pad) ? t_elapsed : std::max(t_elapsed, t_pad + t_accel + t_coast + t_decel);
+            }
+        }
         
         // simulate maneuver
-        if (t_elapsed < 1.0) { // startup message
+        if (t_elapsed < t_pad) { // startup message
 
-            message = "Executing " + maneuver + " Maneuver:";
+            message = maneuver_status(maneuver, Maneuver_Phase::Starting);
 
-        } else if (t_elapsed < (1 + t_accel)) { startup = false; // satellite accelerating
+        } else if (t_elapsed < (t_pad + t_accel)) { startup = false; // satellite accelerating
 
-            message = "Executing " + maneuver + " Maneuver: Accelerating...";
+            message = maneuver_status(maneuver, Maneuver_Phase::Accelerating);
 
             // update the time in current phase
-            t_in_phase = t_elapsed - 1.0;
+            t_in_phase = t_elapsed - t_pad;
             
             // update satellite angular velocity
             omega = alpha * t_in_phase;
 
             // update satellite current point phi angle (in local spherical coords)
-            curr_point.update_local_spherical(coord, offset + alpha * t_in_phase * t_in_phase / 2.0);
+            curr_point.update_local_spherical<coord>(offset + alpha * t_in_phase * t_in_phase / 2.0);
 
-        } else if (t_elapsed < (1 + t_accel + t_coast)) { startup = false; // satellite coasting
+        } else if (t_elapsed < (t_pad + t_accel + t_coast)) { startup = false; // satellite coasting
 
-            message = "Executing " + maneuver + " Maneuver: Coasting...";
+            message = maneuver_status(maneuver, Maneuver_Phase::Coasting);
 
             // update the time in current phase
-            t_in_phase = t_elapsed - t_accel - 1.0;
+            t_in_phase = t_elapsed - t_accel - t_pad;
             
             // update satellite angular velocity
             omega = alpha * t_accel;
 
             // update satellite current point phi angle (in local spherical coords)
-            curr_point.update_local_spherical(coord, offset + alpha * t_accel * t_accel / 2.0 + omega * t_in_phase);
+            curr_point.update_local_spherical<coord>(offset + alpha * t_accel * t_accel / 2.0 + omega * t_in_phase);
 
-        } else if (t_elapsed < (1 + t_accel + t_coast + t_decel)) { startup = false; // satellite decelerating
+        } else if (t_elapsed < (t_pad + t_accel + t_coast + t_decel)) { startup = false; // satellite decelerating
 
-            message = "Executing " + maneuver + " Maneuver: Decelerating...";
+            message = maneuver_status(maneuver, Maneuver_Phase::Decelerating);
 
             // update the time in current phase
-            t_in_phase = t_elapsed - t_accel - t_coast - 1.0;
+            t_in_phase = t_elapsed - t_accel - t_coast - t_pad;
             
             // update satellite angular velocity
             omega = alpha * t_accel - alpha * t_in_phase;
 
             // update satellite current point phi angle (in local spherical coords)
-            curr_point.update_local_spherical(coord, offset + (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_in_phase - alpha * t_in_phase * t_in_phase / 2.0));
+            curr_point.update_local_spherical<coord>(offset + (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_in_phase - alpha * t_in_phase * t_in_phase / 2.0));
 
         } else { startup = false; // maneuver complete (still computing everything though as a means of error checking, even though know the correct final values already)
 
-            message = "Executing " + maneuver + " Maneuver: Complete";
+            message = maneuver_status(maneuver, Maneuver_Phase::Complete);
             
             // update satellite angular velocity
             omega = alpha * t_accel - alpha * t_decel;
 
             // update satellite current point phi angle (in local spherical coords)
-            curr_point.update_local_spherical(coord, offset + (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_decel - alpha * t_decel * t_decel / 2.0));
+            curr_point.update_local_spherical<coord>(offset + (alpha * t_accel * t_accel / 2.0) + (alpha * t_accel * t_coast) + (alpha * t_accel * t_decel - alpha * t_decel * t_decel / 2.0));
         }
 
         // only update satellite information if out of startup phase
         if (startup == false) {
 
             // compute the new global coords after the change in local coords from above
-            curr_point.compute_global_coords(rot_mat_T);
+            curr_point.compute_global_coords(attitude);
 
             // if maneuver is not Roll, apply the sign convention before updating the console output
-            if (maneuver != "Roll") {
+            if constexpr (maneuver != Maneuver_Type::Roll) {
                 omega *= sign;
             }
 
+            // an eigen-axis maneuver is shared by the pitch and yaw wheels, each spins the satellite at its component of the rotation axis
+            if constexpr (maneuver == Maneuver_Type::Eigen_Axis) {
+                omega_pitch = omega * eigen_axis[0];
+                omega_yaw   = omega * eigen_axis[1];
+            }
+
             // update reaction wheel momentum saturation percentage (follows sign convention of maneuver, can be between -100% and 100%)
-            if      (maneuver == "Roll" ) {reaction_wheel_roll.saturation  = 100.0 * omega / reaction_wheel_roll.max_sat_omega; }
-            else if (maneuver == "Pitch") {reaction_wheel_pitch.saturation = 100.0 * omega / reaction_wheel_pitch.max_sat_omega;}
-            else if (maneuver == "Yaw"  ) {reaction_wheel_yaw.saturation   = 100.0 * omega / reaction_wheel_yaw.max_sat_omega;  }
+            if      constexpr (maneuver == Maneuver_Type::Roll ) {reaction_wheel_roll.saturation  = 100.0 * omega / reaction_wheel_roll.max_sat_omega; }
+            else if constexpr (maneuver == Maneuver_Type::Pitch) {reaction_wheel_pitch.saturation = 100.0 * omega / reaction_wheel_pitch.max_sat_omega;}
+            else if constexpr (maneuver == Maneuver_Type::Yaw  ) {reaction_wheel_yaw.saturation   = 100.0 * omega / reaction_wheel_yaw.max_sat_omega;  }
+            else if constexpr (maneuver == Maneuver_Type::Eigen_Axis) {
+                reaction_wheel_pitch.saturation = 100.0 * omega_pitch / reaction_wheel_pitch.max_sat_omega;
+                reaction_wheel_yaw.saturation   = 100.0 * omega_yaw   / reaction_wheel_yaw.max_sat_omega;
+            }
+
+            // keep track of the peak saturation of each reaction wheel over the reorientation
+            last_metrics.peak_saturation_roll  = std::max(last_metrics.peak_saturation_roll , std::abs(reaction_wheel_roll.saturation ));
+            last_metrics.peak_saturation_pitch = std::max(last_metrics.peak_saturation_pitch, std::abs(reaction_wheel_pitch.saturation));
+            last_metrics.peak_saturation_yaw   = std::max(last_metrics.peak_saturation_yaw  , std::abs(reaction_wheel_yaw.saturation  ));
         }
 
         // update the console output
-        print_info(message);
+        Status_Message shown = preempted ? Status_Message::Retargeting : message;
+        print_info(shown);
 
-        // Calculate the sleep duration in milliseconds based on FPS
-        auto sleep_duration = std::chrono::milliseconds(static_cast<long long>(1000.0 / FPS));
+        // wait for the next frame, then hand the thread back until the next frame is wanted
+        sim_clock.end_frame();
+        co_yield shown;
 
-        // Sleep for the calculated duration
-        std::this_thread::sleep_for(sleep_duration);
-    }
+    } while (t_elapsed < t_stop);
+}
+
+// execute the roll, pitch or yaw, and zoom of a plan all at once
+Maneuver_Task Ideal_Cube_Sat::execute_concurrent(const Reorientation_Plan &planned) {
+
+    // profiles being flown (cut short if a new target arrives)
+    Reorientation_Plan plan = planned;
+
+    // pick the wheel and angular velocity of the pitch or yaw maneuver
+    Reaction_Wheel &tilt_wheel = (plan.tilt_axis == Maneuver_Axis::Pitch) ? reaction_wheel_pitch : reaction_wheel_yaw;
+    double         &omega_tilt = (plan.tilt_axis == Maneuver_Axis::Pitch) ? omega_pitch          : omega_yaw;
+
+    // initialize loop variables
+    double t_elapsed = 0.0;                // initialize elapsed time
+    double t_pad     = display_padding;    // time to hold the start and end messages on screen
+    double r_start   = curr_point.local_r; // initialize starting rho distance
+    double r_zoom    = plan.target_r - r_start;
+    double r_end     = plan.target_r;      // rho distance once the zoom stops
+    double t_stop    = plan.total_time + 2.0 * t_pad; // time the last frame starts at or after (sooner if a new target arrives)
+    double roll, theta;                    // angles turned so far by the roll and pitch or yaw maneuvers
+    bool   pitch     = (plan.tilt_axis == Maneuver_Axis::Pitch);
+    Status_Message message;                // initialize message to be displayed in console
+
+    // start the simulation clock for this maneuver
+    sim_clock.start();
+
+    // simulate the motion of the satellite during the maneuver (add padding to display initial starting message and final message after maneuver is complete)
+    do {
+
+        // get elapsed simulation time
+        t_elapsed = sim_clock.elapsed();
+
+        // a new target cuts the maneuver short: both profiles brake right away, the zoom stops where it is, and the end message isn't held
+        if (!preempted) {
+            poll_commands();
+            if (preempted) {
+                double t = t_elapsed - t_pad;
+                preempt_time = std::clamp(t, 0.0, plan.total_time);
+                if (t < plan.zoom_time) {
+                    r_end = (t > 0.0) ? r_start + r_zoom * t / plan.zoom_time : r_start;
+                }
+                brake_bang_coast_bang(t, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel);
+                brake_bang_coast_bang(t, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel);
+                plan.zoom_time  = 0.0;
+                plan.total_time = std::max(plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel, plan.tilt_t_accel + plan.tilt_t_coast + plan.tilt_t_decel);
+                t_stop = (t_elapsed < t_pad) ? t_elapsed : std::max(t_elapsed, t_pad + plan.total_time);
+            }
+        }
+
+        if (t_elapsed < t_pad) { // startup message
+
+            message = pitch ? Status_Message::Concurrent_Pitch_Starting : Status_Message::Concurrent_Yaw_Starting;
+
+        } else {
+
+            // time since the maneuvers started
+            double t = t_elapsed - t_pad;
+
+            if (t < plan.total_time) {
+                message = pitch ? Status_Message::Concurrent_Pitch_In_Progress : Status_Message::Concurrent_Yaw_In_Progress;
+            } else {
+                message = pitch ? Status_Message::Concurrent_Pitch_Complete    : Status_Message::Concurrent_Yaw_Complete;
+            }
+
+            // evaluate both rotation profiles at the current time
+            evaluate_bang_coast_bang(t, plan.roll_alpha, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel, roll , omega_roll);
+            evaluate_bang_coast_bang(t, plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, theta, omega_tilt);
+
+            // apply the sign convention of the pitch or yaw maneuver (display only, see execute_maneuver)
+            omega_tilt *= plan.tilt_sign;
+
+            // update all 3 local spherical coords of the satellite current point at once
+            double r = (plan.zoom_time > 0.0 && t < plan.zoom_time) ? r_start + r_zoom * t / plan.zoom_time : r_end;
+            curr_point.set_local_spherical(r, theta, plan.phi_offset + roll);
+
+            // compute the new global coords after the change in local coords from above
+            curr_point.compute_global_coords(attitude);
+
+            // update reaction wheel momentum saturation percentage (follows sign convention of maneuver, can be between -100% and 100%)
+            reaction_wheel_roll.saturation = 100.0 * omega_roll / reaction_wheel_roll.max_sat_omega;
+            tilt_wheel.saturation          = 100.0 * omega_tilt / tilt_wheel.max_sat_omega;
+
+            // keep track of the peak saturation of each reaction wheel over the reorientation
+            last_metrics.peak_saturation_roll  = std::max(last_metrics.peak_saturation_roll , std::abs(reaction_wheel_roll.saturation ));
+            last_metrics.peak_saturation_pitch = std::max(last_metrics.peak_saturation_pitch, std::abs(reaction_wheel_pitch.saturation));
+            last_metrics.peak_saturation_yaw   = std::max(last_metrics.peak_saturation_yaw  , std::abs(reaction_wheel_yaw.saturation  ));
+        }
+
+        // update the console output
+        Status_Message shown = preempted ? Status_Message::Retargeting : message;
+        print_info(shown);
+
+        // wait for the next frame, then hand the thread back until the next frame is wanted
+        sim_clock.end_frame();
+        co_yield shown;
+
+    } while (t_elapsed < t_stop);
 }
 
 // adjust the zoom level of the satellite
-void Ideal_Cube_Sat::adjust_zoom() {
+Maneuver_Task Ideal_Cube_Sat::adjust_zoom() {
 
     // compute how much the zoom level needs to change
     double r_zoom = targ_point.local_r - curr_point.local_r;
@@ -271,46 +639,62 @@ void Ideal_Cube_Sat::adjust_zoom() {
     double t_zoom = std::abs(r_zoom) / zoom_rate;
 
     // initialize loop variables
-    auto   t_start    = std::chrono::high_resolution_clock::now(); // get current time
-    double t_elapsed  = 0.0;                                       // initialize elapsed time
-    double r_start    = curr_point.local_r;                        // initialize starting rho distance
-    std::string message;                                           // initialize message to be displayed in console
-
-    // simulate the realtime motion of the satellite during the maneuver (add 1s to display final message after maneuver is complete)
-    while (t_elapsed < (t_zoom + 1.0)) {
+    double t_elapsed  = 0.0;                // initialize elapsed time
+    double r_start    = curr_point.local_r; // initialize starting rho distance
+    double r_end      = targ_point.local_r; // rho distance once the zoom stops
+    double t_stop     = t_zoom + display_padding; // time the last frame starts at or after (right away if a new target arrives)
+    Status_Message message;                 // initialize message to be displayed in console
+
+    // start the simulation clock for the zoom
+    sim_clock.start();
+
+    // simulate the motion of the satellite during the maneuver (add padding to display final message after maneuver is complete)
+    // (always runs at least one frame so the final zoom distance is applied even without padding)
+    do {
         
-        // get current time and compute elapsed time
-        auto t_now = std::chrono::high_resolution_clock::now();
-        t_elapsed  = std::chrono::duration<double>(t_now - t_start).count();
+        // get elapsed simulation time
+        t_elapsed = sim_clock.elapsed();
+
+        // a new target stops the zoom where it is (it starts and stops instantly)
+        if (!preempted) {
+            poll_commands();
+            if (preempted) {
+                preempt_time = t_elapsed;
+                if (t_elapsed < t_zoom) {
+                    r_end  = r_start + r_zoom * t_elapsed / t_zoom;
+                    t_zoom = t_elapsed;
+                }
+                t_stop = t_elapsed;
+            }
+        }
 
         // simulate zoom
         if (t_elapsed < t_zoom) { // satellite zooming
 
-            message = "Adjusting Optical Zoom...";
+            message = Status_Message::Zoom_Adjusting;
 
             // update satellite current point r distance (in local spherical coords)
-            curr_point.update_local_spherical("r", r_start + r_zoom * t_elapsed / t_zoom);
+            curr_point.update_local_spherical<Spherical_Coord::R>(r_start + r_zoom * t_elapsed / t_zoom);
 
         } else { // zoom complete
 
-            message = "Optical Zoom Complete";
+            message = Status_Message::Zoom_Complete;
 
             // update satellite current point r distance (in local spherical coords)
-            curr_point.update_local_spherical("r", targ_point.local_r);
+            curr_point.update_local_spherical<Spherical_Coord::R>(r_end);
         }
 
         // compute the new global coords after the change in local coords
-        curr_point.compute_global_coords(rot_mat_T);
+        curr_point.compute_global_coords(attitude);
 
         // update the console output
-        print_info(message);
-
-        // Calculate the sleep duration in milliseconds based on FPS
-        auto sleep_duration = std::chrono::milliseconds(static_cast<long long>(1000.0 / FPS));
+        Status_Message shown = preempted ? Status_Message::Retargeting : message;
+        print_info(shown);
 
-        // Sleep for the calculated duration
-        std::this_thread::sleep_for(sleep_duration);
+        // wait for the next frame, then hand the thread back until the next frame is wanted
+        sim_clock.end_frame();
+        co_yield shown;
 
-    }
+    } while (t_elapsed < t_stop);
 
 }
\ No newline at end of file
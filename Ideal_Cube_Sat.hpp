@@ -8,6 +8,27 @@
 #include "Reaction_Wheel.hpp"
 #include "Location.hpp"
 #include "Helper_Functions.hpp"
+#include "Sim_Clock.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Attitude.hpp"
+#include "Render_Thread.hpp"
+#include "Telemetry_Recorder.hpp"
+#include "Status_Message.hpp"
+#include "Target_Catalog.hpp"
+#include "Satellite_Config.hpp"
+#include "Command_Queue.hpp"
+#include "Maneuver_Task.hpp"
+
+class Command_Server; // (Command_Server.hpp includes this header)
+
+// summary of the most recent reorientation (filled in by Ideal_Cube_Sat::reorient)
+struct Reorient_Metrics {
+    Reorientation_Plan plan;      // plan that was executed (angles, phase times, zoom time)
+    double peak_saturation_roll;  // % (largest absolute roll  reaction wheel saturation reached)
+    double peak_saturation_pitch; // % (largest absolute pitch reaction wheel saturation reached)
+    double peak_saturation_yaw;   // % (largest absolute yaw   reaction wheel saturation reached)
+    double pointing_error;        // rad (angle between the final focus point and the target point)
+};
 
 class Ideal_Cube_Sat {
 
@@ -21,13 +42,33 @@ private:
     double omega_pitch;     // rad/s
     double omega_yaw;       // rad/s
     double zoom_rate;       // coordinate units/s
-    double rot_mat[3][3];   // rotation matrix to go from global to local cartesian coordinate system
-    double rot_mat_T[3][3]; // transpose of rotation matrix to go from local to global cartesian coordinate system
+    Attitude attitude;      // attitude to go from global to local cartesian coordinate system (inverse goes from local to global)
+    bool   headless;        // if true, the console is never written to (batch and regression runs)
+    double display_padding; // s (time the console holds the start and end messages of each maneuver, zero when headless)
+    Sim_Clock sim_clock;    // clock that drives the maneuver physics and frame pacing
+    Planner_Mode planner_mode; // how reorient() slews to a new target
+    double eigen_axis[3];   // unit rotation axis of the eigen-axis maneuver in progress (local cartesian coords)
+    unsigned long long frame; // number of snapshots published
+    Telemetry_Recorder *recorder;       // telemetry recorder every frame is written to (nullptr when not recording)
+    Satellite_Snapshot headless_snapshot; // snapshot filled in when there is no renderer to hand it to (headless recording)
+    const Target_Catalog *catalog;      // target catalog the dashboard looks up the nearest target in (nullptr shows the planet octant)
+    Command_Server *server;             // server every frame is streamed to while a client is subscribed (nullptr when not serving)
+    Command_Queue *commands;            // command lines typed by the user (nullptr when there is nobody to retarget the satellite mid-maneuver)
+    std::string command_line;           // last command line taken from the queue (keeps its capacity between frames)
+    bool   preempted;                   // true once a new target (or "quit") arrived during the current reorientation
+    double preempt_time;                // s (time into the maneuver in progress when it was cut short, see reorient)
+    bool   has_pending_target;          // true if a target typed mid-maneuver is waiting to be slewed to
+    double pending_target[3];           // target typed mid-maneuver (global cartesian coords, the most recent one wins)
+    bool   quit_requested;              // true once the user typed "quit"
+
+    void poll_commands(); // take the command lines typed since the last frame (a valid target or "quit" cuts the current reorientation short)
 
 public:
 
     Console_Manager console_man; // console manager object
 
+    Render_Thread renderer; // draws the published snapshots on the console from its own thread (not started when headless)
+
     Reaction_Wheel reaction_wheel_roll;  // roll  control reaction wheel object (identical for all axis) (defined in this program as rotation about +z axis, see Helper_Functions.cpp for rationalle)
     Reaction_Wheel reaction_wheel_pitch; // pitch control reaction wheel object (identical for all axis) (defined in this program as rotation about +x axis, see Helper_Functions.cpp for rationalle)
     Reaction_Wheel reaction_wheel_yaw;   // yaw   control reaction wheel object (identical for all axis) (defined in this program as rotation about +y axis, see Helper_Functions.cpp for rationalle)
@@ -36,17 +77,50 @@ public:
 
     Location targ_point; // target focused position of the satellite
 
-    void print_info(std::string message); // prints current satellite info to the console
+    Reorient_Metrics last_metrics; // summary of the most recent reorientation
+
+    void print_info(Status_Message message); // publishes current satellite info for the console and the telemetry recorder (never waits for either)
+
+    bool get_new_target(); // get user input for new target point, returns false if the user quit
+
+    bool take_pending_target(double &x, double &y, double &z); // target typed during the last reorientation (global cartesian coords), returns false if there is none
 
-    void get_new_target(); // get user input for new target point
+    bool set_target(double x, double y, double z); // set a new target point directly (global cartesian coords), returns false if the point is not valid
 
     void reorient(); // perform sequence of attitude maneuvers to reorient sattelite to target point
 
-    void execute_maneuver(std::string maneuver, int sign, std::string coord, double angle, double offset, double &omega, double alpha, double t_accel, double t_coast, double t_decel); // execute a single maneuver
+    Maneuver_Task reorient_task(); // reorient() one physics frame per resume() (for interleaving many satellites, see Satellite_Scheduler)
+
+    void plan_reorientation(double x, double y, double z, Reorientation_Plan &plan); // plan a reorientation from the current attitude to a target point (global cartesian coords) without executing it
+
+    const Attitude &get_attitude(); // current attitude (global to local cartesian coords)
+
+    void get_rot_mat(double rot_mat_out[3][3]); // derive the current rotation matrix (global to local cartesian coords)
+
+    double get_zoom_rate(); // optical zoom rate (coordinate units/s)
+
+    double get_frame_period(); // s (physics frame period)
+
+    void set_recorder(Telemetry_Recorder *recorder); // record every frame from now on (nullptr stops recording)
+
+    void set_server(Command_Server *server); // stream every frame to the subscribers of a command server from now on (nullptr stops streaming)
+
+    void set_catalog(const Target_Catalog *catalog); // show the nearest target of a catalog on the dashboard from now on (nullptr shows the planet octant, the catalog must outlive the satellite)
+
+    void set_command_queue(Command_Queue *commands); // watch for new targets typed mid-maneuver from now on, and read targets from it between maneuvers (the queue must outlive the satellite)
+
+    void set_planner_mode(Planner_Mode mode); // select how reorient() slews to a new target
+
+    Planner_Mode get_planner_mode(); // how reorient() slews to a new target
+
+    template <Maneuver_Type maneuver, Spherical_Coord coord>
+    Maneuver_Task execute_maneuver(int sign, double offset, double &omega, double alpha, double t_accel, double t_coast, double t_decel); // execute a single maneuver (the maneuver and the coordinate it moves are fixed at compile time, only instantiated by reorient() in Ideal_Cube_Sat.cpp)
+
+    Maneuver_Task execute_concurrent(const Reorientation_Plan &plan); // execute the roll, pitch or yaw, and zoom of a plan all at once (one frame per resume())
 
-    void adjust_zoom(); // adjust the zoom level of the satellite
+    Maneuver_Task adjust_zoom(); // adjust the zoom level of the satellite (one frame per resume())
 
-    Ideal_Cube_Sat(); // constructor
+    Ideal_Cube_Sat(Clock_Mode clock_mode = Clock_Mode::Wall, double time_scale = 1.0, bool headless = false, const Satellite_Config &config = Satellite_Config()); // constructor
 
 };
 
@@ -16,15 +16,15 @@ Location::Location(double x, double y, double z) {
 }
 
 // compute local coordinates from global coordinates
-void Location::compute_local_coords(double rot_mat[3][3]) {
+void Location::compute_local_coords(const Attitude &attitude) {
 
     // overwrite local cartesian coordinates with global coordinate values
     local_x = global_x;
     local_y = global_y;
     local_z = global_z;
     
-    // apply rotation matrix to local coordinates
-    apply_rotation(rot_mat, local_x, local_y, local_z);
+    // apply the attitude to local coordinates
+    attitude.rotate(local_x, local_y, local_z);
 
     // update local spherical coordinates
     convert_to_spherical(local_x, local_y, local_z, local_r, local_theta, local_phi);
@@ -33,7 +33,7 @@ void Location::compute_local_coords(double rot_mat[3][3]) {
 // rotate local coordinates after completing maneuvers (for console display purposes only, has no functional significance otherwise)
 void Location::rotate_local_coords() {
 
-    // once rotations are complete, points are always aligned with positive z axis (updating values for display purposes on console, rotations already exist in the updated rotation matrix)
+    // once rotations are complete, points are always aligned with positive z axis (updating values for display purposes on console, rotations already exist in the updated attitude)
     local_x = 0.0;
     local_y = 0.0;
     local_z = local_r;
@@ -43,30 +43,35 @@ void Location::rotate_local_coords() {
 }
 
 // compute global coordinates from local coordinates
-void Location::compute_global_coords(double rot_mat_T[3][3]) {
+void Location::compute_global_coords(const Attitude &attitude) {
     
     // overwrite global cartesian coordinates with local coordinates
     global_x = local_x;
     global_y = local_y;
     global_z = local_z;
     
-    // apply transpose of rotation matrix to global coordinates
-    apply_rotation(rot_mat_T, global_x, global_y, global_z);
+    // apply the inverse of the attitude to global coordinates
+    attitude.inverse_rotate(global_x, global_y, global_z);
 }
 
 // update the value of a local spherical coordinate
-void Location::update_local_spherical(std::string coord, double value) {
+void Location::update_local_spherical(Spherical_Coord coord, double value) {
     
-    // update the value specified by coord argument
-    if      (coord == "r"    ) {local_r     = value;}
-    else if (coord == "theta") {local_theta = value;}
-    else if (coord == "phi"  ) {local_phi   = value;}
-    else {
-        
-        // something went wrong, exit program
-        std::cout << "ERROR: Invalid coord in Location::update_local_spherical()" << std::endl;
-        exit(1);
+    // hand off to the compile-time version for the coord argument
+    switch (coord) {
+        case Spherical_Coord::R    : update_local_spherical<Spherical_Coord::R    >(value); break;
+        case Spherical_Coord::Theta: update_local_spherical<Spherical_Coord::Theta>(value); break;
+        case Spherical_Coord::Phi  : update_local_spherical<Spherical_Coord::Phi  >(value); break;
     }
+}
+
+// set all local spherical coordinates at once
+void Location::set_local_spherical(double r, double theta, double phi) {
+
+    // store the new values
+    local_r     = r;
+    local_theta = theta;
+    local_phi   = phi;
 
     // update local cartesian coordinates
     local_x = local_r * sin(local_theta) * cos(local_phi);
@@ -5,6 +5,14 @@
 #include <string>
 #include <iostream>
 #include "Helper_Functions.hpp"
+#include "Attitude.hpp"
+
+// local spherical coordinate selector
+enum class Spherical_Coord {
+    R,     // radius
+    Theta, // polar angle from the +z axis
+    Phi    // azimuth angle from the +x axis
+};
 
 class Location {
 
@@ -23,16 +31,36 @@ public:
 
     Location(double x, double y, double z); // constructor (global cartesian coords)
 
-    void compute_local_coords(double rot_mat[3][3]); // compute local coordinates from global coordinates
+    void compute_local_coords(const Attitude &attitude); // compute local coordinates from global coordinates
 
     void rotate_local_coords(); // rotate local coordinates after completing maneuvers (for console display purposes only, has no functional significance otherwise)
 
-    void compute_global_coords(double rot_mat_T[3][3]); // compute global coordinates from local coordinates
+    void compute_global_coords(const Attitude &attitude); // compute global coordinates from local coordinates
+
+    void update_local_spherical(Spherical_Coord coord, double value); // update the value of a local spherical coordinate
+
+    template <Spherical_Coord coord>
+    void update_local_spherical(double value); // update the value of a local spherical coordinate chosen at compile time (no dispatch, inlines into the maneuver loops)
 
-    void update_local_spherical(std::string coord, double value); // update the value of a local spherical coordinate
+    void set_local_spherical(double r, double theta, double phi); // set all local spherical coordinates at once
 
-    void convert_to_spherical(double x, double y, double z, double &rho, double &theta, double &phi); // convert cartesian coordinates to spherical coordinates
+    static void convert_to_spherical(double x, double y, double z, double &rho, double &theta, double &phi); // convert cartesian coordinates to spherical coordinates
 
 };
 
+// update the value of a local spherical coordinate chosen at compile time (no dispatch, inlines into the maneuver loops)
+template <Spherical_Coord coord>
+void Location::update_local_spherical(double value) {
+
+    // update the value specified by the coord parameter
+    if constexpr (coord == Spherical_Coord::R    ) {local_r     = value;}
+    if constexpr (coord == Spherical_Coord::Theta) {local_theta = value;}
+    if constexpr (coord == Spherical_Coord::Phi  ) {local_phi   = value;}
+
+    // update local cartesian coordinates
+    local_x = local_r * sin(local_theta) * cos(local_phi);
+    local_y = local_r * sin(local_theta) * sin(local_phi);
+    local_z = local_r * cos(local_theta);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "Maneuver_Planner.hpp"
+
+#include <algorithm>
+
+/* Notes:
+    - Everything here is closed form, the same math Ideal_Cube_Sat::reorient executes frame by frame
+    - Nothing is allocated and no satellite or console state is touched, so plans are cheap enough to evaluate for huge numbers of candidate targets
+*/
+
+// plan a reorientation from the current attitude and zoom distance to a target point (global cartesian coords) without simulating any frames,
+// returns false if the target has no usable direction from the attitude (non-finite input, the plan is meaningless)
+bool plan_reorientation(const Attitude &attitude, double curr_r, double x, double y, double z,
+                        const Reaction_Wheel &roll_wheel, const Reaction_Wheel &pitch_wheel, const Reaction_Wheel &yaw_wheel,
+                        double zoom_rate, Reorientation_Plan &plan, Planner_Mode mode) {
+
+    plan.mode = mode;
+
+    // convert the target point's global coords to local coords by applying the current attitude
+    attitude.rotate(x, y, z);
+    Location::convert_to_spherical(x, y, z, plan.target_r, plan.target_theta, plan.target_phi);
+
+    // compute the most efficient roll angle and the subsequent rotation maneuver (fails only for a non-finite direction)
+    bool valid = compute_efficient_roll(plan.target_phi, plan.roll_angle, plan.phi_offset, plan.tilt_axis, plan.tilt_sign);
+
+    // compute the bang-coast-bang profile of both maneuvers
+    const Reaction_Wheel &tilt_wheel = (plan.tilt_axis == Maneuver_Axis::Pitch) ? pitch_wheel : yaw_wheel;
+    roll_wheel.compute_maneuver(plan.roll_angle  , plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel, plan.roll_alpha);
+    tilt_wheel.compute_maneuver(plan.target_theta, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, plan.tilt_alpha);
+
+    // the roll then pitch or yaw slew is always planned, it is the baseline the eigen-axis slew is compared against
+    plan.two_step_slew_time = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel + plan.tilt_t_accel + plan.tilt_t_coast + plan.tilt_t_decel;
+
+    // eigen-axis slew rotates the boresight (+z) straight towards the target, about the unit axis z x target = (-sin(phi), cos(phi), 0)
+    plan.eigen_axis[0] = -sin(plan.target_phi);
+    plan.eigen_axis[1] =  cos(plan.target_phi);
+    plan.eigen_axis[2] =  0.0;
+    plan.eigen_angle   = plan.target_theta;
+
+    // the pitch (x) and yaw (y) wheels share the rotation, each only has to supply its component of the torque and momentum,
+    // so the limits along the axis are set by whichever wheel carries the larger share (the roll wheel isn't needed at all)
+    double share_pitch = std::abs(plan.eigen_axis[0]);
+    double share_yaw   = std::abs(plan.eigen_axis[1]);
+    double alpha_max   = std::min(share_pitch > 0.0 ? pitch_wheel.max_sat_alpha / share_pitch : HUGE_VAL, share_yaw > 0.0 ? yaw_wheel.max_sat_alpha / share_yaw : HUGE_VAL);
+    double omega_max   = std::min(share_pitch > 0.0 ? pitch_wheel.max_sat_omega / share_pitch : HUGE_VAL, share_yaw > 0.0 ? yaw_wheel.max_sat_omega / share_yaw : HUGE_VAL);
+    compute_bang_coast_bang(plan.eigen_angle, alpha_max, omega_max, plan.eigen_t_accel, plan.eigen_t_coast, plan.eigen_t_decel, plan.eigen_alpha);
+
+    if (mode == Planner_Mode::Eigen_Axis) {
+
+        // slew time of the single rotation
+        plan.slew_time = plan.eigen_t_accel + plan.eigen_t_coast + plan.eigen_t_decel;
+
+        // peak saturation of each wheel is its share of the peak angular velocity
+        double omega_peak = std::abs(plan.eigen_alpha * plan.eigen_t_accel);
+        plan.peak_saturation_roll  = 0.0;
+        plan.peak_saturation_pitch = 100.0 * omega_peak * share_pitch / pitch_wheel.max_sat_omega;
+        plan.peak_saturation_yaw   = 100.0 * omega_peak * share_yaw   / yaw_wheel.max_sat_omega;
+
+        // the satellite rotates by +angle about the axis, so coordinates rotate by -angle (the boresight ends up on the target, with a different roll than the two step slew)
+        plan.final_attitude = Attitude::from_axis_angle(plan.eigen_axis[0], plan.eigen_axis[1], plan.eigen_axis[2], -plan.eigen_angle) * attitude;
+
+    } else if (mode == Planner_Mode::Concurrent) {
+
+        /* Roll and pitch or yaw run at the same time on their own wheels, and the zoom runs alongside them.
+           The attitude at time t is tilt(beta(t)) * roll(alpha(t)) * attitude, so the final attitude is exactly the two step one.
+           As with the gyroscopic effects in Reaction_Wheel.cpp, the kinematic coupling between the simultaneous rotations is ignored.
+        */
+
+        // the slew is done when the longer of the two maneuvers is done
+        double roll_time = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel;
+        double tilt_time = plan.tilt_t_accel + plan.tilt_t_coast + plan.tilt_t_decel;
+        plan.slew_time   = std::max(roll_time, tilt_time);
+
+        // stretch the shorter maneuver so both finish together at the lowest possible wheel saturation (costs no time)
+        compute_timed_bang_coast_bang(plan.roll_angle  , plan.slew_time, roll_wheel.max_sat_alpha, roll_wheel.max_sat_omega, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel, plan.roll_alpha);
+        compute_timed_bang_coast_bang(plan.target_theta, plan.slew_time, tilt_wheel.max_sat_alpha, tilt_wheel.max_sat_omega, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, plan.tilt_alpha);
+
+        // peak saturation is reached at the end of the acceleration phase (angular velocity relative to the max the wheel can provide)
+        double peak_saturation_tilt = 100.0 * std::abs(plan.tilt_alpha * plan.tilt_t_accel) / tilt_wheel.max_sat_omega;
+        plan.peak_saturation_roll   = 100.0 * std::abs(plan.roll_alpha * plan.roll_t_accel) / roll_wheel.max_sat_omega;
+        plan.peak_saturation_pitch  = (plan.tilt_axis == Maneuver_Axis::Pitch) ? peak_saturation_tilt : 0.0;
+        plan.peak_saturation_yaw    = (plan.tilt_axis == Maneuver_Axis::Yaw  ) ? peak_saturation_tilt : 0.0;
+
+        // compute the final attitude (same as roll first, then pitch or yaw)
+        plan.final_attitude = Attitude::from_maneuver(plan.tilt_axis, plan.tilt_sign * plan.target_theta) * Attitude::from_maneuver(Maneuver_Axis::Roll, plan.roll_angle) * attitude;
+
+    } else {
+
+        // slew time of the roll then pitch or yaw maneuvers
+        plan.slew_time = plan.two_step_slew_time;
+
+        // peak saturation is reached at the end of the acceleration phase (angular velocity relative to the max the wheel can provide)
+        double peak_saturation_tilt = 100.0 * std::abs(plan.tilt_alpha * plan.tilt_t_accel) / tilt_wheel.max_sat_omega;
+        plan.peak_saturation_roll   = 100.0 * std::abs(plan.roll_alpha * plan.roll_t_accel) / roll_wheel.max_sat_omega;
+        plan.peak_saturation_pitch  = (plan.tilt_axis == Maneuver_Axis::Pitch) ? peak_saturation_tilt : 0.0;
+        plan.peak_saturation_yaw    = (plan.tilt_axis == Maneuver_Axis::Yaw  ) ? peak_saturation_tilt : 0.0;
+
+        // compute the final attitude (roll first, then pitch or yaw)
+        plan.final_attitude = Attitude::from_maneuver(plan.tilt_axis, plan.tilt_sign * plan.target_theta) * Attitude::from_maneuver(Maneuver_Axis::Roll, plan.roll_angle) * attitude;
+    }
+
+    // compute the remaining times (slew and zoom happen one after another, unless they run concurrently)
+    plan.zoom_time  = std::abs(plan.target_r - curr_r) / zoom_rate;
+    plan.total_time = (mode == Planner_Mode::Concurrent) ? std::max(plan.slew_time, plan.zoom_time) : plan.slew_time + plan.zoom_time;
+    plan.time_saved = plan.two_step_slew_time + plan.zoom_time - plan.total_time;
+
+    // keep the attitude a unit quaternion (rounding would otherwise build up over a long chain of reorientations)
+    plan.final_attitude.normalize();
+
+    return valid;
+}
+
+// boresight (focus point) direction in global cartesian coords t seconds into the slew of a plan (attitude is the attitude the plan started from, clamped to the start and end of the slew)
+void boresight_at(const Attitude &attitude, const Reorientation_Plan &plan, double t, double &x, double &y, double &z) {
+
+    // the focus point moves in the local spherical coords of the starting attitude, exactly as Ideal_Cube_Sat::reorient moves it frame by frame
+    double theta, phi, omega;
+    if (plan.mode == Planner_Mode::Eigen_Axis) {
+
+        // straight along the great circle to the target
+        evaluate_bang_coast_bang(t, plan.eigen_alpha, plan.eigen_t_accel, plan.eigen_t_coast, plan.eigen_t_decel, theta, omega);
+        phi = plan.target_phi;
+
+    } else if (plan.mode == Planner_Mode::Concurrent) {
+
+        // roll and pitch or yaw at the same time
+        double roll;
+        evaluate_bang_coast_bang(t, plan.roll_alpha, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel, roll , omega);
+        evaluate_bang_coast_bang(t, plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, theta, omega);
+        phi = plan.phi_offset + roll;
+
+    } else {
+
+        // the roll spins the satellite about the boresight (the focus point doesn't move), then the pitch or yaw tilts it
+        double roll_time = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel;
+        evaluate_bang_coast_bang(t - roll_time, plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, theta, omega);
+        phi = plan.phi_offset + plan.roll_angle;
+    }
+
+    // unit direction in local cartesian coords, then back to global coords
+    x = sin(theta) * cos(phi);
+    y = sin(theta) * sin(phi);
+    z = cos(theta);
+    attitude.inverse_rotate(x, y, z);
+}
+
+// cut the slew of a plan short t seconds in (a new target arrived): every profile still turning brakes right away at the acceleration it spun up with,
+// the angles, slew time, and final attitude become where the satellite comes to rest, the zoom is dropped (attitude is the attitude the plan started from)
+void brake_plan(const Attitude &attitude, double t, Reorientation_Plan &plan) {
+
+    double omega; // (unused, every profile ends at rest)
+
+    if (plan.mode == Planner_Mode::Eigen_Axis) {
+
+        // the single rotation stops short on the same great circle
+        brake_bang_coast_bang(t, plan.eigen_t_accel, plan.eigen_t_coast, plan.eigen_t_decel);
+        plan.slew_time = plan.eigen_t_accel + plan.eigen_t_coast + plan.eigen_t_decel;
+        evaluate_bang_coast_bang(plan.slew_time, plan.eigen_alpha, plan.eigen_t_accel, plan.eigen_t_coast, plan.eigen_t_decel, plan.eigen_angle, omega);
+        plan.target_theta   = plan.eigen_angle;
+        plan.final_attitude = Attitude::from_axis_angle(plan.eigen_axis[0], plan.eigen_axis[1], plan.eigen_axis[2], -plan.eigen_angle) * attitude;
+
+    } else {
+
+        // both profiles brake at the same moment when they run together, one after the other the pitch or yaw only starts once the roll is done
+        double roll_time = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel;
+        double t_tilt    = (plan.mode == Planner_Mode::Concurrent) ? t : t - roll_time;
+        brake_bang_coast_bang(t     , plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel);
+        brake_bang_coast_bang(t_tilt, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel);
+
+        roll_time        = plan.roll_t_accel + plan.roll_t_coast + plan.roll_t_decel;
+        double tilt_time = plan.tilt_t_accel + plan.tilt_t_coast + plan.tilt_t_decel;
+        plan.slew_time   = (plan.mode == Planner_Mode::Concurrent) ? std::max(roll_time, tilt_time) : roll_time + tilt_time;
+
+        // where both profiles come to rest (the focus point ends up at theta, on the roll's phi)
+        evaluate_bang_coast_bang(roll_time, plan.roll_alpha, plan.roll_t_accel, plan.roll_t_coast, plan.roll_t_decel, plan.roll_angle  , omega);
+        evaluate_bang_coast_bang(tilt_time, plan.tilt_alpha, plan.tilt_t_accel, plan.tilt_t_coast, plan.tilt_t_decel, plan.target_theta, omega);
+        plan.final_attitude = Attitude::from_maneuver(plan.tilt_axis, plan.tilt_sign * plan.target_theta) * Attitude::from_maneuver(Maneuver_Axis::Roll, plan.roll_angle) * attitude;
+    }
+    plan.final_attitude.normalize();
+
+    // the zoom never starts (or stops where it is, it starts and stops instantly)
+    plan.zoom_time  = 0.0;
+    plan.total_time = plan.slew_time;
+    plan.time_saved = 0.0;
+}
+
+// short name of a planner mode ("two-step", "eigen", or "concurrent")
+const char *planner_mode_name(Planner_Mode mode) {
+
+    switch (mode) {
+        case Planner_Mode::Roll_Then_Tilt: return "two-step";
+        case Planner_Mode::Eigen_Axis    : return "eigen";
+        case Planner_Mode::Concurrent    : return "concurrent";
+    }
+    return "";
+}
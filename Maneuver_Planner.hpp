@@ -0,0 +1,73 @@
+#ifndef MANEUVER_PLANNER_HPP
+#define MANEUVER_PLANNER_HPP
+
+#include "Helper_Functions.hpp"
+#include "Reaction_Wheel.hpp"
+#include "Location.hpp"
+#include "Attitude.hpp"
+
+// target point in global cartesian coords
+struct Target_Point {
+    double x;
+    double y;
+    double z;
+};
+
+// how the satellite slews to a new target
+enum class Planner_Mode {
+    Roll_Then_Tilt, // roll from compute_efficient_roll, then a single pitch or yaw maneuver (original behavior)
+    Eigen_Axis,     // single rotation about the axis perpendicular to both the boresight and the target (pitch and yaw wheels share the work)
+    Concurrent      // roll, pitch or yaw, and optical zoom all run at the same time (same final attitude as Roll_Then_Tilt)
+};
+
+// closed-form plan of a full reorientation (slew, then optical zoom)
+struct Reorientation_Plan {
+    Planner_Mode mode;            // how the slew is performed
+    double target_r;              // target local spherical radius before the reorientation
+    double target_theta;          // rad (target local spherical theta before the reorientation)
+    double target_phi;            // rad (target local spherical phi before the reorientation)
+    double roll_angle;            // rad (roll maneuver angle)
+    double phi_offset;            // rad (phi offset of the roll maneuver, see compute_efficient_roll)
+    Maneuver_Axis tilt_axis;      // axis of the maneuver that follows the roll (Pitch or Yaw)
+    int    tilt_sign;             // sign convention of the pitch or yaw maneuver
+    double roll_t_accel;          // s (roll maneuver acceleration phase, Concurrent mode stretches the roll and pitch or yaw profiles to finish together)
+    double roll_t_coast;          // s (roll maneuver coasting phase)
+    double roll_t_decel;          // s (roll maneuver deceleration phase)
+    double roll_alpha;            // rad/s^2 (roll maneuver signed angular acceleration)
+    double tilt_t_accel;          // s (pitch or yaw maneuver acceleration phase)
+    double tilt_t_coast;          // s (pitch or yaw maneuver coasting phase)
+    double tilt_t_decel;          // s (pitch or yaw maneuver deceleration phase)
+    double tilt_alpha;            // rad/s^2 (pitch or yaw maneuver angular acceleration, before the sign convention)
+    double eigen_axis[3];         // unit rotation axis of the eigen-axis slew (local cartesian coords before the reorientation)
+    double eigen_angle;           // rad (eigen-axis slew angle, equal to target_theta)
+    double eigen_t_accel;         // s (eigen-axis slew acceleration phase)
+    double eigen_t_coast;         // s (eigen-axis slew coasting phase)
+    double eigen_t_decel;         // s (eigen-axis slew deceleration phase)
+    double eigen_alpha;           // rad/s^2 (eigen-axis slew angular acceleration)
+    double two_step_slew_time;    // s (roll plus pitch or yaw maneuver time, always computed for comparison)
+    double slew_time;             // s (slew time of the selected mode)
+    double zoom_time;             // s (optical zoom time)
+    double total_time;            // s (time until the satellite is on target and zoomed, slew plus zoom unless they run concurrently)
+    double time_saved;            // s (original sequential roll, pitch or yaw, zoom time minus the total time of the selected mode)
+    double peak_saturation_roll;  // % (largest absolute roll  reaction wheel saturation during the reorientation)
+    double peak_saturation_pitch; // % (largest absolute pitch reaction wheel saturation during the reorientation)
+    double peak_saturation_yaw;   // % (largest absolute yaw   reaction wheel saturation during the reorientation)
+    Attitude final_attitude;      // attitude after the reorientation (global to local cartesian coordinates)
+};
+
+// plan a reorientation from the current attitude and zoom distance to a target point (global cartesian coords) without simulating any frames,
+// returns false if the target has no usable direction from the attitude (non-finite input, the plan is meaningless)
+bool plan_reorientation(const Attitude &attitude, double curr_r, double x, double y, double z,
+                        const Reaction_Wheel &roll_wheel, const Reaction_Wheel &pitch_wheel, const Reaction_Wheel &yaw_wheel,
+                        double zoom_rate, Reorientation_Plan &plan, Planner_Mode mode = Planner_Mode::Roll_Then_Tilt);
+
+// boresight (focus point) direction in global cartesian coords t seconds into the slew of a plan (attitude is the attitude the plan started from, clamped to the start and end of the slew)
+void boresight_at(const Attitude &attitude, const Reorientation_Plan &plan, double t, double &x, double &y, double &z);
+
+// cut the slew of a plan short t seconds in (a new target arrived): every profile still turning brakes right away at the acceleration it spun up with,
+// the angles, slew time, and final attitude become where the satellite comes to rest, the zoom is dropped (attitude is the attitude the plan started from)
+void brake_plan(const Attitude &attitude, double t, Reorientation_Plan &plan);
+
+const char *planner_mode_name(Planner_Mode mode); // short name of a planner mode ("two-step", "eigen", or "concurrent")
+
+#endif
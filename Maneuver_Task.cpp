@@ -0,0 +1,169 @@
+#include "Maneuver_Task.hpp"
+
+#include <exception>
+#include <new>
+
+/* Coroutine frame recycling:
+    - Frames are rounded up to a multiple of frame_granularity bytes, each multiple up to frame_classes of them has its own free list
+    - A freed frame goes onto the free list of the thread that frees it (a frame started on one worker and finished on another just moves over),
+      bigger frames than the largest class go straight back to the heap
+*/
+
+static const size_t frame_granularity = 64;  // bytes per size class step
+static const size_t frame_classes     = 64;  // number of size classes (frames up to 4 KB are recycled)
+
+// free block (the first bytes of a recycled frame)
+struct Frame_Block {
+    Frame_Block *next;
+};
+
+// free lists of one thread
+struct Frame_Free_Lists {
+
+    Frame_Block *heads[frame_classes] = {}; // free frames by size class
+
+    // return every free frame to the heap when the thread exits
+    ~Frame_Free_Lists() {
+        for (size_t i = 0; i < frame_classes; i++) {
+            while (heads[i] != nullptr) {
+                Frame_Block *block = heads[i];
+                heads[i] = block->next;
+                ::operator delete(block);
+            }
+        }
+    }
+};
+
+static thread_local Frame_Free_Lists frame_free_lists;
+
+// task that owns the coroutine
+Maneuver_Task Maneuver_Task::promise_type::get_return_object() {
+    return Maneuver_Task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+// nothing runs until the first resume()
+std::suspend_always Maneuver_Task::promise_type::initial_suspend() noexcept {
+    status = Status_Message::None;
+    return {};
+}
+
+// the task destroys the coroutine, not the coroutine itself
+std::suspend_always Maneuver_Task::promise_type::final_suspend() noexcept {
+    return {};
+}
+
+// end of a frame
+std::suspend_always Maneuver_Task::promise_type::yield_value(Status_Message status) noexcept {
+    this->status = status;
+    return {};
+}
+
+// maneuver complete
+void Maneuver_Task::promise_type::return_void() noexcept {
+}
+
+// maneuvers never throw (terminates)
+void Maneuver_Task::promise_type::unhandled_exception() noexcept {
+    std::terminate();
+}
+
+// coroutine frame from this thread's free list (allocated only if the list is empty)
+void *Maneuver_Task::promise_type::operator new(size_t size) {
+
+    size_t size_class = (size - 1) / frame_granularity;
+    if (size_class >= frame_classes) {
+        return ::operator new(size);
+    }
+
+    Frame_Block *&head = frame_free_lists.heads[size_class];
+    if (head != nullptr) {
+        Frame_Block *block = head;
+        head = block->next;
+        return block;
+    }
+    return ::operator new((size_class + 1) * frame_granularity);
+}
+
+// coroutine frame back onto this thread's free list
+void Maneuver_Task::promise_type::operator delete(void *frame, size_t size) noexcept {
+
+    size_t size_class = (size - 1) / frame_granularity;
+    if (size_class >= frame_classes) {
+        ::operator delete(frame);
+        return;
+    }
+
+    Frame_Block *block = static_cast<Frame_Block *>(frame);
+    block->next = frame_free_lists.heads[size_class];
+    frame_free_lists.heads[size_class] = block;
+}
+
+// constructor (no maneuver, done right away)
+Maneuver_Task::Maneuver_Task():
+
+    // no coroutine
+    handle(nullptr)
+
+{
+}
+
+// constructor (owns a coroutine, see get_return_object)
+Maneuver_Task::Maneuver_Task(std::coroutine_handle<promise_type> handle):
+
+    // take over the coroutine
+    handle(handle)
+
+{
+}
+
+// move constructor (the other task is left empty)
+Maneuver_Task::Maneuver_Task(Maneuver_Task &&other) noexcept:
+
+    // take over the other task's coroutine
+    handle(other.handle)
+
+{
+    other.handle = nullptr;
+}
+
+// move assignment (destroys the coroutine this task owned)
+Maneuver_Task &Maneuver_Task::operator=(Maneuver_Task &&other) noexcept {
+
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle       = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+// destructor (destroys the coroutine, even if it hasn't finished)
+Maneuver_Task::~Maneuver_Task() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+// run the next frame, returns false once the maneuver is complete (no frame was run)
+bool Maneuver_Task::resume() {
+
+    if (!handle || handle.done()) {
+        return false;
+    }
+
+    // runs until the end of the next frame, or to the end of the maneuver if there are no frames left
+    handle.resume();
+    return !handle.done();
+}
+
+// true once the maneuver is complete
+bool Maneuver_Task::done() {
+    return !handle || handle.done();
+}
+
+// status message of the last frame (None before the first frame)
+Status_Message Maneuver_Task::status() {
+    return handle ? handle.promise().status : Status_Message::None;
+}
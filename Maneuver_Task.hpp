@@ -0,0 +1,67 @@
+#ifndef MANEUVER_TASK_HPP
+#define MANEUVER_TASK_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include "Status_Message.hpp"
+
+/* Maneuver that runs one physics frame at a time (C++20 coroutine, build with -std=c++20)
+    - Ideal_Cube_Sat's maneuver loops are coroutines that suspend at the end of every frame (co_yield of the status message the frame showed)
+    - resume() runs the next frame, so a caller can either drive one satellite to the end (Ideal_Cube_Sat::reorient)
+      or interleave many satellites on a few threads (Satellite_Scheduler)
+    - Coroutine frames are recycled through a per-thread free list, so once a thread has run each kind of maneuver, starting one never allocates
+*/
+
+class Maneuver_Task {
+
+public:
+
+    // coroutine promise (what the compiler needs to build a Maneuver_Task coroutine)
+    struct promise_type {
+
+        Status_Message status; // status message of the last frame
+
+        Maneuver_Task get_return_object(); // task that owns the coroutine
+
+        std::suspend_always initial_suspend() noexcept; // nothing runs until the first resume()
+
+        std::suspend_always final_suspend() noexcept; // the task destroys the coroutine, not the coroutine itself
+
+        std::suspend_always yield_value(Status_Message status) noexcept; // end of a frame
+
+        void return_void() noexcept; // maneuver complete
+
+        void unhandled_exception() noexcept; // maneuvers never throw (terminates)
+
+        static void *operator new(size_t size); // coroutine frame from this thread's free list (allocated only if the list is empty)
+
+        static void operator delete(void *frame, size_t size) noexcept; // coroutine frame back onto this thread's free list
+
+    };
+
+    Maneuver_Task(); // constructor (no maneuver, done right away)
+
+    explicit Maneuver_Task(std::coroutine_handle<promise_type> handle); // constructor (owns a coroutine, see get_return_object)
+
+    Maneuver_Task(Maneuver_Task &&other) noexcept; // move constructor (the other task is left empty)
+
+    Maneuver_Task &operator=(Maneuver_Task &&other) noexcept; // move assignment (destroys the coroutine this task owned)
+
+    Maneuver_Task(const Maneuver_Task &) = delete;            // a coroutine has one owner
+    Maneuver_Task &operator=(const Maneuver_Task &) = delete; // a coroutine has one owner
+
+    ~Maneuver_Task(); // destructor (destroys the coroutine, even if it hasn't finished)
+
+    bool resume(); // run the next frame, returns false once the maneuver is complete (no frame was run)
+
+    bool done(); // true once the maneuver is complete
+
+    Status_Message status(); // status message of the last frame (None before the first frame)
+
+private:
+
+    std::coroutine_handle<promise_type> handle; // coroutine of the maneuver (null for an empty task)
+
+};
+
+#endif
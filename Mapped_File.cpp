@@ -0,0 +1,174 @@
+#include "Mapped_File.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// constructor (maps the whole file read-only)
+Mapped_File::Mapped_File(const char *path) {
+
+    // start out unmapped
+    data_ptr  = nullptr;
+    data_size = 0;
+    opened    = false;
+    writable  = false;
+
+#ifdef _WIN32
+
+    mapping_handle = nullptr;
+
+    // open the file for reading
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    // get the file size
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        return;
+    }
+    data_size = static_cast<size_t>(file_size.QuadPart);
+
+    // an empty file can't be mapped, but it is still a valid (empty) file
+    if (data_size == 0) {
+        opened = true;
+        return;
+    }
+
+    // map the whole file into memory
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        return;
+    }
+    data_ptr = static_cast<char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    opened   = (data_ptr != nullptr);
+
+#else
+
+    // open the file for reading
+    file_descriptor = open(path, O_RDONLY);
+    if (file_descriptor < 0) {
+        return;
+    }
+
+    // get the file size
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) != 0) {
+        return;
+    }
+    data_size = static_cast<size_t>(file_stat.st_size);
+
+    // an empty file can't be mapped, but it is still a valid (empty) file
+    if (data_size == 0) {
+        opened = true;
+        return;
+    }
+
+    // map the whole file into memory
+    void *mapping = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+
+    // the file is read front to back, let the kernel read ahead aggressively
+    madvise(mapping, data_size, MADV_SEQUENTIAL);
+
+    data_ptr = static_cast<char *>(mapping);
+    opened   = true;
+
+#endif
+}
+
+// constructor (creates or truncates the file to size bytes and maps it read-write)
+Mapped_File::Mapped_File(const char *path, size_t size) {
+
+    // start out unmapped
+    data_ptr  = nullptr;
+    data_size = size;
+    opened    = false;
+    writable  = false;
+
+#ifdef _WIN32
+
+    mapping_handle = nullptr;
+
+    // create the file (readers may open it while it is being written)
+    file_handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE || size == 0) {
+        return;
+    }
+
+    // the mapping object sets the file size
+    unsigned long long size_64 = size;
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READWRITE, static_cast<DWORD>(size_64 >> 32), static_cast<DWORD>(size_64 & 0xFFFFFFFFull), nullptr);
+    if (mapping_handle == nullptr) {
+        return;
+    }
+    data_ptr = static_cast<char *>(MapViewOfFile(mapping_handle, FILE_MAP_WRITE, 0, 0, 0));
+
+#else
+
+    // create the file (readers may open it while it is being written)
+    file_descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_descriptor < 0 || size == 0) {
+        return;
+    }
+
+    // set the file size (the file stays sparse until pages are written)
+    if (ftruncate(file_descriptor, static_cast<off_t>(size)) != 0) {
+        return;
+    }
+
+    // map the whole file, shared so every write goes to the file
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+    data_ptr = static_cast<char *>(mapping);
+
+#endif
+
+    opened   = (data_ptr != nullptr);
+    writable = opened;
+}
+
+// destructor (unmaps and closes the file)
+Mapped_File::~Mapped_File() {
+
+#ifdef _WIN32
+
+    if (data_ptr != nullptr)                  {UnmapViewOfFile(data_ptr);     }
+    if (mapping_handle != nullptr)            {CloseHandle(mapping_handle);   }
+    if (file_handle != INVALID_HANDLE_VALUE)  {CloseHandle(file_handle);      }
+
+#else
+
+    if (data_ptr != nullptr)   {munmap(data_ptr, data_size);}
+    if (file_descriptor >= 0)  {close(file_descriptor);     }
+
+#endif
+}
+
+// true if the file was mapped successfully
+bool Mapped_File::is_open() {
+    return opened;
+}
+
+// start of the mapped file contents
+const char *Mapped_File::data() {
+    return data_ptr;
+}
+
+// start of the mapped file contents (nullptr unless mapped read-write)
+char *Mapped_File::writable_data() {
+    return writable ? data_ptr : nullptr;
+}
+
+// size of the mapped file contents (bytes)
+size_t Mapped_File::size() {
+    return data_size;
+}
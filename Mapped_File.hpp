@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+class Mapped_File {
+
+private:
+
+    char       *data_ptr;  // start of the mapped file contents (nullptr if the file is empty or could not be opened)
+    size_t      data_size; // size of the mapped file contents (bytes)
+    bool        opened;    // true if the file was opened and mapped successfully
+    bool        writable;  // true if the mapping can be written to (changes go straight to the file)
+
+#ifdef _WIN32
+    HANDLE file_handle;    // handle to the open file
+    HANDLE mapping_handle; // handle to the file mapping object
+#else
+    int file_descriptor;   // descriptor of the open file
+#endif
+
+public:
+
+    Mapped_File(const char *path); // constructor (maps the whole file read-only)
+
+    Mapped_File(const char *path, size_t size); // constructor (creates or truncates the file to size bytes and maps it read-write)
+
+    ~Mapped_File(); // destructor (unmaps and closes the file)
+
+    Mapped_File(const Mapped_File &) = delete;            // mapping can't be shared between objects
+    Mapped_File &operator=(const Mapped_File &) = delete; // mapping can't be shared between objects
+
+    bool is_open(); // true if the file was mapped successfully
+
+    const char *data(); // start of the mapped file contents
+
+    char *writable_data(); // start of the mapped file contents (nullptr unless mapped read-write)
+
+    size_t size(); // size of the mapped file contents (bytes)
+
+};
+
+#endif
@@ -0,0 +1,199 @@
+#include "Parameter_Sweep.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "Ideal_Cube_Sat.hpp"
+
+// constructor (no swept properties, every config starts from base)
+Parameter_Sweep::Parameter_Sweep(const Satellite_Config &base) {
+    this->base = base;
+    samples    = 1;
+    seed       = 1;
+}
+
+// read a sweep file, returns false (after reporting the problem) if it can't be read or holds an invalid line
+bool Parameter_Sweep::load(const char *path) {
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "ERROR: Unable to open sweep file '" << path << "'" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+
+        // drop comments, skip blank lines
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) {
+            continue;
+        }
+
+        // run settings
+        if (name == "samples" || name == "seed") {
+            long long value;
+            std::string extra;
+            if (!(fields >> value) || (fields >> extra) || value < (name == "samples" ? 1 : 0)) {
+                std::cerr << "ERROR: Expected \"" << name << " <count>\" on line " << line_number << " of '" << path << "'" << std::endl;
+                return false;
+            }
+            if (name == "samples") {samples = static_cast<size_t>(value);  }
+            else                   {seed    = static_cast<uint64_t>(value);}
+            continue;
+        }
+
+        // swept property (checked against the config's property names)
+        Satellite_Config check;
+        if (!check.set(name.c_str(), 0.0)) {
+            std::cerr << "ERROR: Unknown satellite property '" << name << "' on line " << line_number << " of '" << path << "'" << std::endl;
+            return false;
+        }
+        Sweep_Parameter parameter;
+        parameter.name = name;
+        parameter.low  = 0.0;
+        parameter.high = 0.0;
+
+        std::string word;
+        std::streampos values_start = fields.tellg();
+        if ((fields >> word) && word == "uniform") {
+
+            // random property
+            std::string extra;
+            if (!(fields >> parameter.low >> parameter.high) || (fields >> extra) || parameter.high < parameter.low) {
+                std::cerr << "ERROR: Expected \"" << name << " uniform <low> <high>\" on line " << line_number << " of '" << path << "'" << std::endl;
+                return false;
+            }
+
+        } else {
+
+            // list of grid values
+            fields.clear();
+            fields.seekg(values_start);
+            double value;
+            while (fields >> value) {
+                parameter.values.push_back(value);
+            }
+            if (!fields.eof() || parameter.values.empty()) {
+                std::cerr << "ERROR: Expected \"" << name << " <value> [<value> ...]\" on line " << line_number << " of '" << path << "'" << std::endl;
+                return false;
+            }
+        }
+
+        parameters.push_back(parameter);
+    }
+
+    return true;
+}
+
+// every config of the sweep (grid points in file order, the last property varying fastest, samples of a grid point together)
+void Parameter_Sweep::generate(std::vector<Satellite_Config> &configs) const {
+
+    configs.clear();
+
+    // number of grid points (a sweep with no grid properties is a single point)
+    size_t points = 1;
+    for (const Sweep_Parameter &p : parameters) {
+        if (!p.values.empty()) {
+            points *= p.values.size();
+        }
+    }
+
+    // draws are made up front in a fixed order, so the configs never depend on how the runs are scheduled
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t point = 0; point < points; point++) {
+        for (size_t sample = 0; sample < samples; sample++) {
+
+            Satellite_Config config = base;
+            size_t stride = points;
+            for (const Sweep_Parameter &p : parameters) {
+                if (p.values.empty()) {
+                    config.set(p.name.c_str(), p.low + (p.high - p.low) * uniform(rng));
+                } else {
+                    stride /= p.values.size();
+                    config.set(p.name.c_str(), p.values[(point / stride) % p.values.size()]);
+                }
+            }
+            configs.push_back(config);
+        }
+    }
+}
+
+// reorient a headless satellite with a config to every target in order (step clock) and aggregate the results
+void Parameter_Sweep::run_campaign(const Satellite_Config &config, const std::vector<Target_Point> &targets, Planner_Mode mode, Sweep_Result &result) {
+
+    auto t_wall_start = std::chrono::steady_clock::now();
+
+    result = Sweep_Result();
+    result.config  = config;
+    result.problem = config.check();
+    if (result.problem != nullptr) {
+        return;
+    }
+
+    // a fresh satellite per campaign (every campaign starts from the same attitude)
+    Ideal_Cube_Sat sat(Clock_Mode::Stepped, 1.0, true, config);
+    sat.set_planner_mode(mode);
+
+    std::vector<double> slew_times;
+    slew_times.reserve(targets.size());
+    for (const Target_Point &target : targets) {
+
+        if (!sat.set_target(target.x, target.y, target.z)) {
+            continue;
+        }
+        sat.reorient();
+
+        // accumulate the results of this reorientation
+        const Reorient_Metrics &m = sat.last_metrics;
+        slew_times.push_back(m.plan.slew_time);
+        result.total_time += m.plan.total_time;
+        const double peak[3] = {m.peak_saturation_roll, m.peak_saturation_pitch, m.peak_saturation_yaw};
+        for (int axis = 0; axis < 3; axis++) {
+            result.saturation_mean[axis] += peak[axis];
+            result.saturation_max[axis]   = std::max(result.saturation_max[axis], peak[axis]);
+        }
+        result.pointing_error_max = std::max(result.pointing_error_max, m.pointing_error);
+    }
+
+    // turn the sums into means and the slew times into percentiles
+    result.reorientations = slew_times.size();
+    if (!slew_times.empty()) {
+        double count = static_cast<double>(slew_times.size());
+        for (int axis = 0; axis < 3; axis++) {
+            result.saturation_mean[axis] /= count;
+        }
+        double sum = 0.0;
+        for (double t : slew_times) {
+            sum += t;
+        }
+        result.slew_mean = sum / count;
+        std::sort(slew_times.begin(), slew_times.end());
+        result.slew_p50 = slew_times[static_cast<size_t>(0.50 * (count - 1.0) + 0.5)];
+        result.slew_p95 = slew_times[static_cast<size_t>(0.95 * (count - 1.0) + 0.5)];
+        result.slew_max = slew_times.back();
+    }
+
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+}
+
+// run a campaign per config spread across the pool, results in config order
+void Parameter_Sweep::run(const std::vector<Satellite_Config> &configs, const std::vector<Target_Point> &targets, Planner_Mode mode, Work_Stealing_Pool &pool, std::vector<Sweep_Result> &results) {
+
+    // every campaign writes its own slot, so the workers never share anything but the (read only) targets
+    results.assign(configs.size(), Sweep_Result());
+    pool.run(configs.size(), [&](size_t index, unsigned) {
+        run_campaign(configs[index], targets, mode, results[index]);
+    });
+}
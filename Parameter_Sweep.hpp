@@ -0,0 +1,65 @@
+#ifndef PARAMETER_SWEEP_HPP
+#define PARAMETER_SWEEP_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Satellite_Config.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Work_Stealing_Pool.hpp"
+
+/* Sweep file format (one parameter per line, '#' starts a comment, property names as in Satellite_Config):
+    - "name v1 v2 v3 ..." sweeps a property over a list of values (every combination of the listed values is a grid point)
+    - "name uniform low high" draws a property uniformly from [low, high] for every sample
+    - "samples n" runs n random draws per grid point (default 1), "seed s" seeds the draws (default 1, the same file always gives the same configs)
+    - properties that aren't listed keep the value of the base config
+*/
+
+// aggregate statistics of one reorientation campaign (every target of a target list, in order, with one satellite config)
+struct Sweep_Result {
+    Satellite_Config config;        // satellite config of the campaign
+    const char *problem;            // what is wrong with the config (nullptr if it was run)
+    size_t reorientations;          // number of targets visited
+    double slew_mean;               // s (mean slew time)
+    double slew_p50;                // s (median slew time)
+    double slew_p95;                // s (95th percentile slew time)
+    double slew_max;                // s (longest slew time)
+    double total_time;              // s (slew and zoom time of the whole campaign)
+    double saturation_mean[3];      // % (mean peak reaction wheel saturation per reorientation, roll/pitch/yaw)
+    double saturation_max[3];       // % (largest peak reaction wheel saturation of the campaign, roll/pitch/yaw)
+    double pointing_error_max;      // rad (largest final pointing error of the campaign)
+    double wall_time;               // s (wall clock time the campaign took to simulate)
+};
+
+class Parameter_Sweep {
+
+private:
+
+    // one swept property
+    struct Sweep_Parameter {
+        std::string name;           // property name (see Satellite_Config)
+        std::vector<double> values; // grid values (empty for a random property)
+        double low;                 // lower bound of a random property
+        double high;                // upper bound of a random property
+    };
+
+    Satellite_Config base;                   // config every sweep point starts from
+    std::vector<Sweep_Parameter> parameters; // swept properties, in file order
+    size_t samples;                          // random draws per grid point
+    uint64_t seed;                           // seed of the random draws
+
+public:
+
+    Parameter_Sweep(const Satellite_Config &base); // constructor (no swept properties, every config starts from base)
+
+    bool load(const char *path); // read a sweep file, returns false (after reporting the problem) if it can't be read or holds an invalid line
+
+    void generate(std::vector<Satellite_Config> &configs) const; // every config of the sweep (grid points in file order, the last property varying fastest, samples of a grid point together)
+
+    static void run_campaign(const Satellite_Config &config, const std::vector<Target_Point> &targets, Planner_Mode mode, Sweep_Result &result); // reorient a headless satellite with a config to every target in order (step clock) and aggregate the results
+
+    static void run(const std::vector<Satellite_Config> &configs, const std::vector<Target_Point> &targets, Planner_Mode mode, Work_Stealing_Pool &pool, std::vector<Sweep_Result> &results); // run a campaign per config spread across the pool, results in config order
+
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "Planner_Api.h"
+#include "Maneuver_Planner.hpp"
+#include "Satellite_Config.hpp"
+
+#include <cmath>
+
+// the C planner modes are the Planner_Mode values
+static_assert(static_cast<int>(Planner_Mode::Roll_Then_Tilt) == SAT_PLANNER_TWO_STEP  , "C planner modes out of step with Planner_Mode");
+static_assert(static_cast<int>(Planner_Mode::Eigen_Axis    ) == SAT_PLANNER_EIGEN     , "C planner modes out of step with Planner_Mode");
+static_assert(static_cast<int>(Planner_Mode::Concurrent    ) == SAT_PLANNER_CONCURRENT, "C planner modes out of step with Planner_Mode");
+
+// copy the C config into a Satellite_Config
+static Satellite_Config to_satellite_config(const sat_planner_config &config) {
+
+    Satellite_Config result;
+    result.mass                 = config.mass;
+    result.size                 = config.size;
+    result.inertia              = config.inertia;
+    result.max_torque           = config.max_torque;
+    result.max_angular_momentum = config.max_angular_momentum;
+    result.zoom_rate            = config.zoom_rate;
+    return result;
+}
+
+// SAT_PLANNER_ABI_VERSION of the library (compare with the header the caller was built with)
+int sat_planner_abi_version(void) {
+    return SAT_PLANNER_ABI_VERSION;
+}
+
+// fill in the original 16 kg, 0.2 m cube sat
+void sat_planner_default_config(sat_planner_config *config) {
+
+    if (config == nullptr) {
+        return;
+    }
+
+    Satellite_Config defaults;
+    config->mass                 = defaults.mass;
+    config->size                 = defaults.size;
+    config->inertia              = defaults.inertia;
+    config->max_torque           = defaults.max_torque;
+    config->max_angular_momentum = defaults.max_angular_momentum;
+    config->zoom_rate            = defaults.zoom_rate;
+}
+
+// what is wrong with a config (NULL if every property is usable, the text is static)
+const char *sat_planner_check_config(const sat_planner_config *config) {
+
+    if (config == nullptr) {
+        return "config is NULL";
+    }
+    return to_satellite_config(*config).check();
+}
+
+// plan a reorientation from each of attitude_count starting attitudes to each of target_count targets, returns a SAT_PLANNER_* code
+int sat_plan_batch(const sat_planner_config *config, int planner_mode,
+                   const double *attitudes, const double *zoom_distances, size_t attitude_count,
+                   const double *targets, size_t target_count,
+                   sat_plan_result *results) {
+
+    // nothing can be thrown across the C boundary, so every argument is checked up front (the planner itself never throws)
+    if (config == nullptr || planner_mode < SAT_PLANNER_TWO_STEP || planner_mode > SAT_PLANNER_CONCURRENT) {
+        return SAT_PLANNER_INVALID_ARGUMENT;
+    }
+    if ((attitude_count > 0 && target_count > 0) && (attitudes == nullptr || targets == nullptr || results == nullptr)) {
+        return SAT_PLANNER_INVALID_ARGUMENT;
+    }
+    Satellite_Config sat_config = to_satellite_config(*config);
+    if (sat_config.check() != nullptr) {
+        return SAT_PLANNER_INVALID_CONFIG;
+    }
+    Planner_Mode mode = static_cast<Planner_Mode>(planner_mode);
+
+    // every starting attitude needs a direction and every zoom distance a length (checked before any result is written)
+    for (size_t a = 0; a < attitude_count && target_count > 0; a++) {
+        const double *q = attitudes + 4 * a;
+        bool finite = std::isfinite(q[0]) && std::isfinite(q[1]) && std::isfinite(q[2]) && std::isfinite(q[3]);
+        if (!finite || (q[0] == 0.0 && q[1] == 0.0 && q[2] == 0.0 && q[3] == 0.0)) {
+            return SAT_PLANNER_INVALID_ARGUMENT;
+        }
+        if (zoom_distances != nullptr && !(std::isfinite(zoom_distances[a]) && zoom_distances[a] > 0.0)) {
+            return SAT_PLANNER_INVALID_ARGUMENT;
+        }
+    }
+
+    // the reaction wheels are the same for every plan of the batch
+    double inertia = sat_config.get_inertia();
+    Reaction_Wheel roll_wheel( inertia, sat_config.max_torque, sat_config.max_angular_momentum);
+    Reaction_Wheel pitch_wheel(inertia, sat_config.max_torque, sat_config.max_angular_momentum);
+    Reaction_Wheel yaw_wheel(  inertia, sat_config.max_torque, sat_config.max_angular_momentum);
+
+    Reorientation_Plan plan;
+    for (size_t a = 0; a < attitude_count; a++) {
+
+        // starting attitude and zoom distance
+        Attitude attitude(attitudes[4 * a], attitudes[4 * a + 1], attitudes[4 * a + 2], attitudes[4 * a + 3]);
+        attitude.normalize();
+        double curr_r = (zoom_distances != nullptr) ? zoom_distances[a] : 1.0;
+
+        sat_plan_result *row = results + a * target_count;
+        for (size_t t = 0; t < target_count; t++) {
+
+            sat_plan_result &result = row[t];
+            result = sat_plan_result();
+
+            // the origin and non-finite points have no direction, so they can't be pointed at (same rule as Ideal_Cube_Sat::set_target)
+            double x = targets[3 * t], y = targets[3 * t + 1], z = targets[3 * t + 2];
+            if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z) || (x == 0.0 && y == 0.0 && z == 0.0)) {
+                continue;
+            }
+
+            if (!plan_reorientation(attitude, curr_r, x, y, z, roll_wheel, pitch_wheel, yaw_wheel, sat_config.zoom_rate, plan, mode)) {
+                result = sat_plan_result();
+                continue;
+            }
+            result.slew_time          = plan.slew_time;
+            result.zoom_time          = plan.zoom_time;
+            result.total_time         = plan.total_time;
+            result.time_saved         = plan.time_saved;
+            result.two_step_slew_time = plan.two_step_slew_time;
+            result.final_attitude[0]  = plan.final_attitude.w;
+            result.final_attitude[1]  = plan.final_attitude.x;
+            result.final_attitude[2]  = plan.final_attitude.y;
+            result.final_attitude[3]  = plan.final_attitude.z;
+            result.peak_saturation[0] = plan.peak_saturation_roll;
+            result.peak_saturation[1] = plan.peak_saturation_pitch;
+            result.peak_saturation[2] = plan.peak_saturation_yaw;
+            result.valid              = 1;
+        }
+    }
+
+    return SAT_PLANNER_OK;
+}
@@ -0,0 +1,88 @@
+#ifndef PLANNER_API_H
+#define PLANNER_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* C interface of the reorientation planner (for schedulers and other tools that plan in-process instead of running the simulator)
+    - Covers the console free core only: Attitude, Helper_Functions, Location, Reaction_Wheel, Maneuver_Planner, and Satellite_Config
+      (see "Planner library" in README.txt for building it as a static or shared library)
+    - Every call plans a whole batch into arrays the caller provides, nothing is allocated and there is no global state,
+      so any number of threads can call in at once (each with its own result array)
+    - Plans are the closed form plans Ideal_Cube_Sat::reorient executes frame by frame (same angles, phase times, and final attitude)
+    - Attitudes are quaternions (w, x, y, z) that take global cartesian coords to local cartesian coords, the identity points the boresight at (0, 0, 1)
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// symbols exported from a shared library build (on Windows define SAT_PLANNER_SHARED for a DLL, both when building and using it, plus SAT_PLANNER_BUILD while building it)
+#if defined(_WIN32) && defined(SAT_PLANNER_SHARED)
+#ifdef SAT_PLANNER_BUILD
+#define SAT_PLANNER_API __declspec(dllexport)
+#else
+#define SAT_PLANNER_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define SAT_PLANNER_API __attribute__((visibility("default")))
+#else
+#define SAT_PLANNER_API
+#endif
+
+#define SAT_PLANNER_ABI_VERSION 1 // bumped whenever a struct layout or function signature changes
+
+// how the satellite slews (same order as Planner_Mode)
+#define SAT_PLANNER_TWO_STEP   0 // roll, then a single pitch or yaw maneuver
+#define SAT_PLANNER_EIGEN      1 // single rotation about the eigen axis
+#define SAT_PLANNER_CONCURRENT 2 // roll, pitch or yaw, and zoom all at once
+
+// return codes
+#define SAT_PLANNER_OK               0  // batch planned
+#define SAT_PLANNER_INVALID_ARGUMENT -1 // null array, unknown planner mode, non-finite or zero attitude quaternion, or non-finite or non-positive zoom distance
+#define SAT_PLANNER_INVALID_CONFIG   -2 // satellite properties can't be simulated (see sat_planner_check_config)
+
+// satellite and reaction wheel properties (same as Satellite_Config)
+typedef struct sat_planner_config {
+    double mass;                 // kg
+    double size;                 // m (edge length of the cube)
+    double inertia;              // kg*m^2 (same about every axis, zero derives it from the mass and size of a uniform cube)
+    double max_torque;           // N*m (reaction wheel, same for all 3 axes)
+    double max_angular_momentum; // N*m*s (reaction wheel, same for all 3 axes)
+    double zoom_rate;            // coordinate units/s
+} sat_planner_config;
+
+// plan of one reorientation
+typedef struct sat_plan_result {
+    double  slew_time;          // s (slew time of the selected mode)
+    double  zoom_time;          // s (optical zoom time)
+    double  total_time;         // s (until the satellite is on target and zoomed)
+    double  time_saved;         // s (original sequential roll, pitch or yaw, zoom time minus the total time)
+    double  two_step_slew_time; // s (roll plus pitch or yaw maneuver time, for comparison)
+    double  final_attitude[4];  // attitude quaternion after the reorientation (w, x, y, z)
+    double  peak_saturation[3]; // % (largest absolute roll, pitch, yaw reaction wheel saturation)
+    int32_t valid;              // 1 if planned, 0 if the target is not valid (0 0 0 or a non-finite coordinate, everything else is zero)
+    int32_t reserved;           // zero
+} sat_plan_result;
+
+SAT_PLANNER_API int sat_planner_abi_version(void); // SAT_PLANNER_ABI_VERSION of the library (compare with the header the caller was built with)
+
+SAT_PLANNER_API void sat_planner_default_config(sat_planner_config *config); // fill in the original 16 kg, 0.2 m cube sat
+
+SAT_PLANNER_API const char *sat_planner_check_config(const sat_planner_config *config); // what is wrong with a config (NULL if every property is usable, the text is static)
+
+// plan a reorientation from each of attitude_count starting attitudes to each of target_count targets, returns a SAT_PLANNER_* code
+//   attitudes      attitude_count quaternions, 4 doubles each (w, x, y, z), normalized before use (finite and not all zero)
+//   zoom_distances attitude_count starting zoom distances, finite and positive (NULL starts every attitude at 1, the simulator's starting zoom)
+//   targets        target_count target points, 3 doubles each (global cartesian coords)
+//   results        attitude_count * target_count plans, results[a * target_count + t] is attitude a to target t
+SAT_PLANNER_API int sat_plan_batch(const sat_planner_config *config, int planner_mode,
+                                   const double *attitudes, const double *zoom_distances, size_t attitude_count,
+                                   const double *targets, size_t target_count,
+                                   sat_plan_result *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,13 +10,13 @@
     - reaction torque on satellite from reaction wheel occurs at satellite centroid
 */
 
-// constructor
-Reaction_Wheel::Reaction_Wheel(double sat_inertia) {
+// constructor (satellite inertia about the wheel axis, wheel specification defaults to the original wheel)
+Reaction_Wheel::Reaction_Wheel(double sat_inertia, double max_torque, double max_angular_momentum) {
 
     // initialize reaction wheel parameters
-    max_torque           = 0.012;
-    max_angular_momentum = 0.03;
-    saturation           = 0.0;
+    this->max_torque           = max_torque;
+    this->max_angular_momentum = max_angular_momentum;
+    saturation                 = 0.0;
 
     // compute how long it takes to saturate the reaction wheel at max torque (see README png for derivation)
     time_to_max_momentum = max_angular_momentum / max_torque;
@@ -32,7 +32,7 @@ Reaction_Wheel::Reaction_Wheel(double sat_inertia) {
 }
 
 // compute the time required to complete a maneuver and acceleration during accel/decel phases
-void Reaction_Wheel::compute_maneuver(double angle, double &t_accel, double &t_coast, double &t_decel, double &alpha) {
+void Reaction_Wheel::compute_maneuver(double angle, double &t_accel, double &t_coast, double &t_decel, double &alpha) const {
     
     // handle condition when the angle is zero (no maneuver required)
     if (angle == 0.0) {
@@ -41,6 +41,7 @@ void Reaction_Wheel::compute_maneuver(double angle, double &t_accel, double &t_c
         t_accel = 0.0;
         t_coast = 0.0;
         t_decel = 0.0;
+        alpha   = 0.0;
         return;
     }
 
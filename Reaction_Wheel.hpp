@@ -18,9 +18,9 @@ public:
     double max_sat_omega;        // rad/s (max angular velocity the satellite will rotate at from the reaction wheel accelerating to max angular momentum at max torque)
     double max_sat_alpha;        // rad/s^2 (angular acceleration the satellite will experience during the reaction wheel accelerating to max angular momentum at max torque)
 
-    Reaction_Wheel(double sat_inertia); // constructor
+    Reaction_Wheel(double sat_inertia, double max_torque = 0.012, double max_angular_momentum = 0.03); // constructor (satellite inertia about the wheel axis, wheel specification defaults to the original wheel)
 
-    void compute_maneuver(double angle, double &t_accel, double &t_coast, double &t_decel, double &alpha); // compute the time required to complete a maneuver and acceleration during accel/decel phases
+    void compute_maneuver(double angle, double &t_accel, double &t_coast, double &t_decel, double &alpha) const; // compute the time required to complete a maneuver and acceleration during accel/decel phases
 
 };
 
@@ -0,0 +1,148 @@
+#include "Render_Thread.hpp"
+
+// constructor (doesn't start the thread)
+Render_Thread::Render_Thread(Console_Manager &console_man, double FPS):
+
+    // store the console to draw on
+    console_man(console_man)
+
+{
+    this->FPS       = FPS;
+    running         = false;
+    pause_requested = false;
+    paused          = false;
+    published       = 0;
+    drawn           = 0;
+    redraw_requested = false;
+}
+
+// destructor (draws the last snapshot and joins the thread)
+Render_Thread::~Render_Thread() {
+
+    if (!thread.joinable()) {
+        return;
+    }
+
+    // ask the render thread to stop
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        running = false;
+    }
+    control.notify_all();
+    thread.join();
+}
+
+// start the render thread
+void Render_Thread::start() {
+
+    if (thread.joinable()) {
+        return;
+    }
+    running = true;
+    thread  = std::thread(&Render_Thread::run, this);
+}
+
+// snapshot to fill in before publish() (physics thread only)
+Satellite_Snapshot &Render_Thread::snapshot() {
+    return buffer.write_slot();
+}
+
+// make the filled in snapshot the latest one (physics thread only, never blocks)
+void Render_Thread::publish() {
+    buffer.publish();
+    published.fetch_add(1, std::memory_order_relaxed);
+}
+
+// draw the latest snapshot, then stop drawing until resume() (so the console can be used for input)
+void Render_Thread::pause() {
+
+    // without a render thread, draw right here
+    if (!thread.joinable()) {
+        draw_latest();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(control_mutex);
+    pause_requested = true;
+    control.notify_all();
+    control.wait(lock, [this] {return paused;});
+}
+
+// start drawing again
+void Render_Thread::resume() {
+
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        pause_requested = false;
+    }
+    control.notify_all();
+}
+
+// draw the next frame in full, even if the snapshot hasn't changed (any thread, never blocks)
+void Render_Thread::redraw() {
+    redraw_requested.store(true, std::memory_order_relaxed);
+}
+
+// number of snapshots published
+unsigned long long Render_Thread::get_published() {
+    return published.load(std::memory_order_relaxed);
+}
+
+// number of snapshots drawn (the rest were dropped)
+unsigned long long Render_Thread::get_drawn() {
+    return drawn.load(std::memory_order_relaxed);
+}
+
+// draw the latest snapshot if there is a new one
+void Render_Thread::draw_latest() {
+
+    // a full redraw wipes whatever was typed over the dashboard (the latest snapshot is drawn again if there is no new one)
+    bool fresh = buffer.fetch();
+    if (redraw_requested.exchange(false, std::memory_order_relaxed)) {
+        console_man.invalidate();
+        fresh = true;
+    }
+
+    if (fresh) {
+        console_man.update(buffer.read_slot());
+        drawn.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// render loop
+void Render_Thread::run() {
+
+    const std::chrono::nanoseconds frame_period(static_cast<long long>(1e9 / FPS));
+    std::chrono::steady_clock::time_point next_frame = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(control_mutex);
+    while (running) {
+
+        // hand the console over: draw whatever is latest, then wait for resume() (or stop)
+        if (pause_requested) {
+            draw_latest();
+            paused = true;
+            control.notify_all();
+            control.wait(lock, [this] {return !pause_requested || !running;});
+            paused = false;
+            next_frame = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        // draw the latest snapshot (the lock only guards the control flags, the physics thread never takes it)
+        lock.unlock();
+        draw_latest();
+        lock.lock();
+
+        // wait for the next frame (a late frame isn't made up for, the renderer just skips ahead)
+        next_frame += frame_period;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (next_frame < now) {
+            next_frame = now;
+        }
+        control.wait_until(lock, next_frame, [this] {return pause_requested || !running;});
+    }
+
+    // show the final state before exiting
+    draw_latest();
+}
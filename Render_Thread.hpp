@@ -0,0 +1,64 @@
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Console_Manager.hpp"
+#include "Satellite_Snapshot.hpp"
+#include "Triple_Buffer.hpp"
+
+/* Dashboard renderer running on its own thread
+    - The physics thread fills in a snapshot and publishes it through a lock-free triple buffer, it never waits for the terminal
+    - The render thread draws the latest snapshot at its own rate, snapshots published in between are dropped
+    - pause() and resume() hand the console over to the physics thread for user input (not part of the frame loop, so they may block)
+    - redraw() asks for the next frame to be drawn in full (text typed mid-maneuver scrolls the terminal under the dashboard)
+*/
+
+class Render_Thread {
+
+private:
+
+    Console_Manager &console_man;              // console the snapshots are drawn on
+    Triple_Buffer<Satellite_Snapshot> buffer;  // snapshots on their way from the physics thread to the render thread
+    double FPS;                                // max frames per second drawn
+    std::thread thread;                        // the render thread (not started in headless mode)
+    std::mutex control_mutex;                  // guards running, pause_requested, and paused
+    std::condition_variable control;           // wakes the render thread up for pause/stop, and the caller of pause() once paused
+    bool running;                              // false once the render thread should exit
+    bool pause_requested;                      // true while the physics thread is using the console
+    bool paused;                               // true once the render thread has stopped drawing
+    std::atomic<unsigned long long> published; // number of snapshots published
+    std::atomic<unsigned long long> drawn;     // number of snapshots drawn
+    std::atomic<bool> redraw_requested;        // true if the next frame has to be drawn in full
+
+    void run(); // render loop
+
+    void draw_latest(); // draw the latest snapshot if there is a new one
+
+public:
+
+    Render_Thread(Console_Manager &console_man, double FPS); // constructor (doesn't start the thread)
+
+    ~Render_Thread(); // destructor (draws the last snapshot and joins the thread)
+
+    void start(); // start the render thread
+
+    Satellite_Snapshot &snapshot(); // snapshot to fill in before publish() (physics thread only)
+
+    void publish(); // make the filled in snapshot the latest one (physics thread only, never blocks)
+
+    void pause(); // draw the latest snapshot, then stop drawing until resume() (so the console can be used for input)
+
+    void resume(); // start drawing again
+
+    void redraw(); // draw the next frame in full, even if the snapshot hasn't changed (any thread, never blocks)
+
+    unsigned long long get_published(); // number of snapshots published
+
+    unsigned long long get_drawn(); // number of snapshots drawn (the rest were dropped)
+
+};
+
+#endif
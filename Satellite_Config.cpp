@@ -0,0 +1,113 @@
+#include "Satellite_Config.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// every property name, in declaration order
+const char *const Satellite_Config::property_names[6] = {"mass", "size", "inertia", "max_torque", "max_angular_momentum", "zoom_rate"};
+
+// constructor (the original cube sat)
+Satellite_Config::Satellite_Config() {
+    mass                 = 16.0;
+    size                 = 0.2;
+    inertia              = 0.0;
+    max_torque           = 0.012;
+    max_angular_momentum = 0.03;
+    zoom_rate            = 1.5;
+}
+
+// kg*m^2 (the inertia if one was given, otherwise the uniform cube's)
+double Satellite_Config::get_inertia() const {
+    return (inertia > 0.0) ? inertia : mass * (size * size) / 6.0;
+}
+
+// set a property by name ("mass", "size", "inertia", "max_torque", "max_angular_momentum", "zoom_rate"), returns false for an unknown name
+bool Satellite_Config::set(const char *name, double value) {
+
+    if      (std::strcmp(name, "mass"                ) == 0) {mass                 = value;}
+    else if (std::strcmp(name, "size"                ) == 0) {size                 = value;}
+    else if (std::strcmp(name, "inertia"             ) == 0) {inertia              = value;}
+    else if (std::strcmp(name, "max_torque"          ) == 0) {max_torque           = value;}
+    else if (std::strcmp(name, "max_angular_momentum") == 0) {max_angular_momentum = value;}
+    else if (std::strcmp(name, "zoom_rate"           ) == 0) {zoom_rate            = value;}
+    else {return false;}
+    return true;
+}
+
+// value of a property by its index in property_names
+double Satellite_Config::get(int property) const {
+
+    switch (property) {
+        case 0: return mass;
+        case 1: return size;
+        case 2: return inertia;
+        case 3: return max_torque;
+        case 4: return max_angular_momentum;
+        case 5: return zoom_rate;
+    }
+    return 0.0;
+}
+
+// what is wrong with the config (nullptr if every property is usable)
+const char *Satellite_Config::check() const {
+
+    // written so that NaN fails every test (it compares false with everything)
+    if (!(get_inertia() > 0.0)          || !std::isfinite(get_inertia()))          {return "mass and size (or inertia) must be positive and finite";}
+    if (!(inertia >= 0.0)               || !std::isfinite(inertia))                {return "inertia can't be negative or infinite";}
+    if (!(max_torque > 0.0)             || !std::isfinite(max_torque))             {return "max_torque must be positive and finite";}
+    if (!(max_angular_momentum > 0.0)   || !std::isfinite(max_angular_momentum))   {return "max_angular_momentum must be positive and finite";}
+    if (!(zoom_rate > 0.0)              || !std::isfinite(zoom_rate))              {return "zoom_rate must be positive and finite";}
+    return nullptr;
+}
+
+// read a config file, returns false (after reporting the problem) if it can't be read or holds an invalid line
+bool Satellite_Config::load(const char *path) {
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "ERROR: Unable to open satellite config file '" << path << "'" << std::endl;
+        return false;
+    }
+
+    // one "name value" pair per line
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+
+        // drop comments, skip blank lines
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) {
+            continue;
+        }
+
+        double value;
+        std::string extra;
+        if (!(fields >> value) || (fields >> extra)) {
+            std::cerr << "ERROR: Expected \"name value\" on line " << line_number << " of '" << path << "'" << std::endl;
+            return false;
+        }
+        if (!set(name.c_str(), value)) {
+            std::cerr << "ERROR: Unknown satellite property '" << name << "' on line " << line_number << " of '" << path << "'" << std::endl;
+            return false;
+        }
+    }
+
+    // the whole config has to make sense
+    const char *problem = check();
+    if (problem != nullptr) {
+        std::cerr << "ERROR: Invalid satellite config '" << path << "' (" << problem << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
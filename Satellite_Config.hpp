@@ -0,0 +1,35 @@
+#ifndef SATELLITE_CONFIG_HPP
+#define SATELLITE_CONFIG_HPP
+
+/* Physical properties of the satellite and its reaction wheels
+    - Defaults are the original 16 kg, 0.2 m cube sat with 0.012 N*m / 0.03 N*m*s wheels and a zoom rate of 1.5 units/s
+    - Config files hold one "name value" pair per line with the property names below ('#' starts a comment),
+      properties that aren't listed keep their defaults
+*/
+
+struct Satellite_Config {
+
+    double mass;                 // kg
+    double size;                 // m (edge length of the cube)
+    double inertia;              // kg*m^2 (same about every axis, zero derives it from the mass and size of a uniform cube)
+    double max_torque;           // N*m (reaction wheel, same for all 3 axes)
+    double max_angular_momentum; // N*m*s (reaction wheel, same for all 3 axes)
+    double zoom_rate;            // coordinate units/s
+
+    Satellite_Config(); // constructor (the original cube sat)
+
+    double get_inertia() const; // kg*m^2 (the inertia if one was given, otherwise the uniform cube's)
+
+    bool set(const char *name, double value); // set a property by name ("mass", "size", "inertia", "max_torque", "max_angular_momentum", "zoom_rate"), returns false for an unknown name
+
+    const char *check() const; // what is wrong with the config (nullptr if every property is usable)
+
+    bool load(const char *path); // read a config file, returns false (after reporting the problem) if it can't be read or holds an invalid line
+
+    static const char *const property_names[6]; // every property name, in declaration order
+
+    double get(int property) const; // value of a property by its index in property_names
+
+};
+
+#endif
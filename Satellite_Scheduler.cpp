@@ -0,0 +1,95 @@
+#include "Satellite_Scheduler.hpp"
+
+#include <algorithm>
+
+// constructor (zero threads means one per core)
+Satellite_Scheduler::Satellite_Scheduler(unsigned thread_count, size_t chunk_size):
+
+    // start the worker threads once, they sleep between steps
+    pool(thread_count),
+
+    // at least one task per job
+    chunk_size(chunk_size > 0 ? chunk_size : 1),
+
+    // nothing run yet
+    frames(0),
+    steps(0)
+
+{
+}
+
+// schedule a task (not resumed until the next step)
+void Satellite_Scheduler::add(Maneuver_Task &&task) {
+
+    // a task that is already complete never needs a thread
+    if (task.done()) {
+        return;
+    }
+    active.push_back(tasks.size());
+    tasks.push_back(std::move(task));
+    finished.push_back(0);
+}
+
+// resume every unfinished task once, returns false once every task has finished
+bool Satellite_Scheduler::step() {
+
+    if (active.empty()) {
+        return false;
+    }
+
+    // one pool job per chunk of active tasks (each task belongs to exactly one job, so no two threads ever resume the same satellite)
+    size_t jobs = (active.size() + chunk_size - 1) / chunk_size;
+    pool.run(jobs, [this](size_t job, unsigned) {
+
+        size_t begin = job * chunk_size;
+        size_t end   = std::min(begin + chunk_size, active.size());
+        uint64_t chunk_frames = 0;
+        for (size_t i = begin; i < end; i++) {
+            size_t index = active[i];
+            if (tasks[index].resume()) {
+                chunk_frames++;
+            } else {
+                finished[index] = 1;
+            }
+        }
+        frames.fetch_add(chunk_frames, std::memory_order_relaxed);
+    });
+    steps++;
+
+    // drop the tasks that finished (keeps the order of the rest, so chunks stay the same from step to step)
+    size_t kept = 0;
+    for (size_t i = 0; i < active.size(); i++) {
+        if (!finished[active[i]]) {
+            active[kept++] = active[i];
+        }
+    }
+    active.resize(kept);
+
+    return !active.empty();
+}
+
+// step until every task has finished
+void Satellite_Scheduler::run() {
+    while (step()) {
+    }
+}
+
+// number of tasks that haven't finished yet
+size_t Satellite_Scheduler::get_active() {
+    return active.size();
+}
+
+// number of frames run over all tasks and steps
+uint64_t Satellite_Scheduler::get_frames() {
+    return frames.load(std::memory_order_relaxed);
+}
+
+// number of steps run
+uint64_t Satellite_Scheduler::get_steps() {
+    return steps;
+}
+
+// number of threads the tasks are resumed on
+unsigned Satellite_Scheduler::get_thread_count() {
+    return pool.get_thread_count();
+}
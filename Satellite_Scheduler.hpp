@@ -0,0 +1,49 @@
+#ifndef SATELLITE_SCHEDULER_HPP
+#define SATELLITE_SCHEDULER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Maneuver_Task.hpp"
+#include "Work_Stealing_Pool.hpp"
+
+/* Interleaves the maneuver tasks of many satellites on a small pool of threads
+    - Each step() resumes every unfinished task once (one physics frame each), chunks of tasks are spread across the pool by work stealing
+    - A satellite is never resumed by two threads at once, but it can move between threads from one step to the next
+    - Meant for satellites on the step clock (Clock_Mode::Stepped), a wall or warp clock would sleep inside resume() and hold up the whole chunk
+*/
+
+class Satellite_Scheduler {
+
+private:
+
+    Work_Stealing_Pool pool;          // threads the tasks are resumed on
+    std::vector<Maneuver_Task> tasks; // every task added (finished tasks are kept until the scheduler is destroyed)
+    std::vector<size_t> active;       // indices of the tasks that haven't finished yet
+    std::vector<uint8_t> finished;    // 1 if a task finished during the current step (one byte per task, so workers never share a flag)
+    size_t chunk_size;                // tasks resumed per pool job
+    std::atomic<uint64_t> frames;     // number of frames run over all tasks and steps
+    uint64_t steps;                   // number of steps run
+
+public:
+
+    Satellite_Scheduler(unsigned thread_count, size_t chunk_size = 64); // constructor (zero threads means one per core)
+
+    void add(Maneuver_Task &&task); // schedule a task (not resumed until the next step)
+
+    bool step(); // resume every unfinished task once, returns false once every task has finished
+
+    void run(); // step until every task has finished
+
+    size_t get_active(); // number of tasks that haven't finished yet
+
+    uint64_t get_frames(); // number of frames run over all tasks and steps
+
+    uint64_t get_steps(); // number of steps run
+
+    unsigned get_thread_count(); // number of threads the tasks are resumed on
+
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SATELLITE_SNAPSHOT_HPP
+#define SATELLITE_SNAPSHOT_HPP
+
+#include "Attitude.hpp"
+#include "Status_Message.hpp"
+
+// immutable copy of everything the dashboard shows for one physics frame (plain data, so it can be copied between threads without locks)
+struct Satellite_Snapshot {
+    unsigned long long frame;  // physics frame counter (increases by one per published snapshot)
+    double sim_time;           // s (simulation clock time of the maneuver in progress)
+    double targ_global[3];     // target point global cartesian coords
+    double curr_global[3];     // current focus point global cartesian coords
+    double targ_local[3];      // target point local cartesian coords
+    double curr_local[3];      // current focus point local cartesian coords
+    double targ_spherical[3];  // target point local spherical coords (r, theta, phi) [-, rad, rad]
+    double curr_spherical[3];  // current focus point local spherical coords (r, theta, phi) [-, rad, rad]
+    Attitude attitude;         // satellite attitude (global to local cartesian coords)
+    double omega_roll;         // rad/s
+    double omega_pitch;        // rad/s
+    double omega_yaw;          // rad/s
+    double saturation_roll;    // % (roll  reaction wheel saturation)
+    double saturation_pitch;   // % (pitch reaction wheel saturation)
+    double saturation_yaw;     // % (yaw   reaction wheel saturation)
+    double zoom_dist;          // optical zoom distance
+    double frame_time;         // s (wall clock time of the previous frame, zero with the step clock)
+    double sleep_overshoot;    // s (how late the previous frame's sleep woke up past its deadline)
+    bool   missed_deadline;    // true if the previous frame ended past its deadline
+    double frame_p50;          // s (median frame time of the maneuver in progress, zero with the step clock)
+    double frame_p99;          // s (99th percentile frame time of the maneuver in progress)
+    double jitter_p99;         // s (99th percentile distance of a frame time from the frame period)
+    double overshoot_max;      // s (largest sleep overshoot of the maneuver in progress)
+    unsigned long long frames_timed;  // frames of the maneuver in progress measured against the wall clock
+    unsigned long long frames_missed; // frames of the maneuver in progress that missed their deadline
+    Status_Message status;     // status message code
+    char   message[120];       // status message text (empty string for none, the status text unless a tool shows its own)
+    char   catalog_name[48];   // name of the catalog target nearest the focus point direction (empty string when there is no catalog, the planet octant is shown instead)
+    double catalog_angle;      // rad (angle between the focus point direction and that catalog target)
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "Screen_Buffer.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+// constructor (frame size in character cells)
+Screen_Buffer::Screen_Buffer(int rows, int cols) {
+
+    // allocate the cells once, frames never allocate
+    this->rows = rows;
+    this->cols = cols;
+    cells.assign(static_cast<size_t>(rows) * cols, ' ');
+    displayed.assign(static_cast<size_t>(rows) * cols, ' ');
+    output.reserve(static_cast<size_t>(rows) * (cols + 16));
+
+    // whatever is on the terminal now is unknown, the first frame is drawn in full
+    displayed_valid = false;
+
+#ifdef _WIN32
+    // get handle to the console window and let it interpret ANSI escape sequences
+    console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(console_handle, &mode)) {
+        SetConsoleMode(console_handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+}
+
+// blank the frame being composed
+void Screen_Buffer::clear() {
+    std::memset(cells.data(), ' ', cells.size());
+}
+
+// copy '\n' separated lines of text into the frame being composed, one row per line from the top (truncated to the frame size)
+void Screen_Buffer::print_lines(const char *text, size_t length) {
+
+    const char *end = text + length;
+    for (int row = 0; row < rows && text < end; row++) {
+
+        // find the end of this line
+        const char *line_end = static_cast<const char *>(std::memchr(text, '\n', static_cast<size_t>(end - text)));
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+
+        // copy as much of it as fits, the rest of the row stays blank
+        size_t count = static_cast<size_t>(line_end - text);
+        if (count > static_cast<size_t>(cols)) {
+            count = static_cast<size_t>(cols);
+        }
+        std::memcpy(&cells[static_cast<size_t>(row) * cols], text, count);
+
+        text = line_end + 1;
+    }
+}
+
+// append a cursor positioning escape sequence (zero based row and column)
+void Screen_Buffer::append_cursor(int row, int col) {
+
+    char sequence[32];
+    int length = std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row + 1, col + 1);
+    output.append(sequence, static_cast<size_t>(length));
+}
+
+// send the cells that changed since the last frame to the terminal
+void Screen_Buffer::present() {
+
+    output.clear();
+
+    // unknown terminal content: clear it, then everything that isn't blank counts as changed
+    if (!displayed_valid) {
+        output.append("\x1b[H\x1b[2J");
+        std::memset(displayed.data(), ' ', displayed.size());
+        displayed_valid = true;
+    }
+
+    // a gap of unchanged cells shorter than this is resent rather than skipped (a cursor move costs about as much)
+    const int merge_gap = 8;
+
+    // find the runs of changed cells in each row
+    int last_used_row = -1;
+    for (int row = 0; row < rows; row++) {
+
+        const char *now    = &cells[static_cast<size_t>(row) * cols];
+        char       *before = &displayed[static_cast<size_t>(row) * cols];
+
+        int col = 0;
+        while (col < cols) {
+
+            // skip unchanged cells
+            if (now[col] == before[col]) {
+                col++;
+                continue;
+            }
+
+            // extend the run until a long enough stretch of unchanged cells
+            int start = col;
+            int end   = col + 1;
+            for (int scan = end; scan < cols && scan - end < merge_gap; scan++) {
+                if (now[scan] != before[scan]) {
+                    end = scan + 1;
+                }
+            }
+
+            // move there and write the run
+            append_cursor(row, start);
+            output.append(now + start, static_cast<size_t>(end - start));
+            std::memcpy(before + start, now + start, static_cast<size_t>(end - start));
+            col = end;
+        }
+
+        // remember the last row that has any text on it
+        for (int c = 0; c < cols; c++) {
+            if (now[c] != ' ') {
+                last_used_row = row;
+                break;
+            }
+        }
+    }
+
+    // nothing changed, nothing to send
+    if (output.empty()) {
+        return;
+    }
+
+    // leave the cursor one blank line below the frame (where the console prompt and input go)
+    append_cursor(last_used_row + 2, 0);
+
+    write_output();
+}
+
+// clear the whole terminal right away (the next frame is drawn on a blank screen)
+void Screen_Buffer::clear_terminal() {
+
+    output.assign("\x1b[H\x1b[2J");
+    write_output();
+
+    std::memset(displayed.data(), ' ', displayed.size());
+    displayed_valid = true;
+}
+
+// the terminal content is unknown (e.g. the user typed something), the next frame is drawn in full
+void Screen_Buffer::invalidate() {
+    displayed_valid = false;
+}
+
+// send the output buffer to the terminal in one write
+void Screen_Buffer::write_output() {
+
+    // anything already written through the C++ and C streams has to reach the terminal first
+    std::cout.flush();
+    std::fflush(stdout);
+
+#ifdef _WIN32
+    DWORD written = 0;
+    WriteFile(console_handle, output.data(), static_cast<DWORD>(output.size()), &written, nullptr);
+#else
+    // a terminal takes the whole frame at once, only a pipe or signal can split it
+    size_t offset = 0;
+    while (offset < output.size()) {
+        ssize_t written = write(STDOUT_FILENO, output.data() + offset, output.size() - offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        offset += static_cast<size_t>(written);
+    }
+#endif
+}
@@ -0,0 +1,53 @@
+#ifndef SCREEN_BUFFER_HPP
+#define SCREEN_BUFFER_HPP
+
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+/* Cell-level terminal frame buffer with ANSI/VT output
+    - A frame is composed into a grid of character cells, then present() compares it with what the terminal already shows
+      and sends only the cells that changed (cursor positioning escape sequences plus the changed text)
+    - Each frame goes out in a single write (WriteFile on Windows, write() everywhere else)
+    - Works on any ANSI terminal (Linux, macOS, SSH sessions, and Windows 10+ consoles with virtual terminal processing enabled)
+*/
+
+class Screen_Buffer {
+
+private:
+
+    int rows;                    // number of rows in the frame
+    int cols;                    // number of columns in the frame
+    std::vector<char> cells;     // frame being composed (rows * cols characters)
+    std::vector<char> displayed; // what the terminal currently shows (same layout as cells)
+    bool displayed_valid;        // false if the terminal content is unknown (the next frame is drawn in full)
+    std::string output;          // escape sequences and text of one frame (keeps its capacity between frames)
+
+#ifdef _WIN32
+    HANDLE console_handle;       // handle to the console window
+#endif
+
+    void write_output(); // send the output buffer to the terminal in one write
+
+    void append_cursor(int row, int col); // append a cursor positioning escape sequence (zero based row and column)
+
+public:
+
+    Screen_Buffer(int rows, int cols); // constructor (frame size in character cells)
+
+    void clear(); // blank the frame being composed
+
+    void print_lines(const char *text, size_t length); // copy '\n' separated lines of text into the frame being composed, one row per line from the top (truncated to the frame size)
+
+    void present(); // send the cells that changed since the last frame to the terminal
+
+    void clear_terminal(); // clear the whole terminal right away (the next frame is drawn on a blank screen)
+
+    void invalidate(); // the terminal content is unknown (e.g. the user typed something), the next frame is drawn in full
+
+};
+
+#endif
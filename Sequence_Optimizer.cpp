@@ -0,0 +1,323 @@
+#include "Sequence_Optimizer.hpp"
+
+#include <algorithm>
+
+/* Notes:
+    - The time to reach a target depends on the attitude left behind by the previous reorientation (the attitude chain),
+      so the cost of a visiting order can only be computed exactly by replaying the chain with plan_reorientation
+    - Moves are screened by re-planning only the positions they change plus a short lookahead, then every accepted pass
+      is verified by replaying the whole chain (a pass that turns out worse is undone)
+    - Searches are spread across a work stealing pool that lives as long as the optimizer (the greedy seed runs one search
+      per target, so starting threads per search would cost more than the search itself), each pool job is a block of indices
+*/
+
+// run function(index, thread_index) for every index in [0, count), spread across the pool's workers in blocks of grain indices
+template <typename Function>
+static void parallel_for(Work_Stealing_Pool &pool, size_t count, size_t grain, Function function) {
+
+    // not worth waking the workers for small amounts of work
+    if (pool.get_thread_count() <= 1 || count <= grain) {
+        for (size_t index = 0; index < count; index++) {
+            function(index, 0u);
+        }
+        return;
+    }
+
+    // one pool job per block of indices
+    size_t blocks = (count + grain - 1) / grain;
+    pool.run(blocks, [&](size_t block, unsigned thread_index) {
+        size_t begin = block * grain;
+        size_t end   = std::min(count, begin + grain);
+        for (size_t index = begin; index < end; index++) {
+            function(index, thread_index);
+        }
+    });
+}
+
+// constructor (plans from the satellite's current attitude and hardware)
+Sequence_Optimizer::Sequence_Optimizer(Ideal_Cube_Sat &sat, const std::vector<Target_Point> &targets, unsigned thread_count):
+
+    // store the target list and copy the satellite hardware (the optimizer never touches the satellite itself)
+    targets(targets),
+    roll_wheel( sat.reaction_wheel_roll ),
+    pitch_wheel(sat.reaction_wheel_pitch),
+    yaw_wheel(  sat.reaction_wheel_yaw  ),
+
+    // start the worker threads once (at least one thread)
+    pool(std::max(1u, thread_count))
+
+{
+    // starting attitude is wherever the satellite is now
+    start.attitude = sat.get_attitude();
+    start.r      = sat.curr_point.local_r;
+    zoom_rate    = sat.get_zoom_rate();
+    planner_mode = sat.get_planner_mode();
+
+    // workers 1 and up are the pool's threads, worker 0 is the calling thread
+    this->thread_count = pool.get_thread_count();
+
+    // search limits (larger values search more moves per pass but each pass gets slower)
+    window    = 24;
+    lookahead = 6;
+}
+
+// plan one reorientation, returns its total time
+double Sequence_Optimizer::step(const Attitude_State &from, size_t target, Attitude_State &to) {
+
+    // plan the reorientation to the target from the given attitude
+    Reorientation_Plan plan;
+    const Target_Point &p = targets[target];
+    plan_reorientation(from.attitude, from.r, p.x, p.y, p.z, roll_wheel, pitch_wheel, yaw_wheel, zoom_rate, plan, planner_mode);
+
+    // the satellite ends up with the planned attitude, zoomed to the target distance
+    to.attitude = plan.final_attitude;
+    to.r = plan.target_r;
+
+    return plan.total_time;
+}
+
+// total time of a visiting order (exact, replays the whole attitude chain)
+double Sequence_Optimizer::evaluate(const std::vector<size_t> &order) {
+
+    Attitude_State state = start;
+    Attitude_State next;
+    double total = 0.0;
+    for (size_t target : order) {
+        total += step(state, target, next);
+        state  = next;
+    }
+    return total;
+}
+
+// recompute states and prefix_cost for a visiting order
+void Sequence_Optimizer::build_prefix(const std::vector<size_t> &order) {
+
+    states.resize(order.size() + 1);
+    prefix_cost.resize(order.size() + 1);
+
+    // replay the chain, storing the attitude and running total after every visit
+    states[0]      = start;
+    prefix_cost[0] = 0.0;
+    for (size_t k = 0; k < order.size(); k++) {
+        prefix_cost[k + 1] = prefix_cost[k] + step(states[k], order[k], states[k + 1]);
+    }
+}
+
+// greedy seed order (always visit the cheapest next target)
+void Sequence_Optimizer::nearest_neighbour(std::vector<size_t> &order) {
+
+    // every target starts out unvisited
+    std::vector<size_t> remaining(targets.size());
+    for (size_t i = 0; i < remaining.size(); i++) {
+        remaining[i] = i;
+    }
+
+    // best candidate found by each worker thread
+    std::vector<Candidate> best(thread_count);
+
+    order.clear();
+    order.reserve(targets.size());
+    Attitude_State state = start;
+
+    while (!remaining.empty()) {
+
+        // reset the per-thread best candidates
+        for (Candidate &candidate : best) {
+            candidate.cost  = HUGE_VAL;
+            candidate.index = remaining.size();
+        }
+
+        // find the cheapest unvisited target from the current attitude
+        parallel_for(pool, remaining.size(), 256, [&](size_t index, unsigned thread_index) {
+            Attitude_State unused;
+            double cost = step(state, remaining[index], unused);
+            Candidate &candidate = best[thread_index];
+            if (cost < candidate.cost || (cost == candidate.cost && index < candidate.index)) {
+                candidate.cost  = cost;
+                candidate.index = index;
+            }
+        });
+
+        // combine the per-thread results (ties go to the lowest index so the result doesn't depend on thread timing)
+        size_t chosen = best[0].index;
+        double cost   = best[0].cost;
+        for (unsigned t = 1; t < thread_count; t++) {
+            if (best[t].cost < cost || (best[t].cost == cost && best[t].index < chosen)) {
+                cost   = best[t].cost;
+                chosen = best[t].index;
+            }
+        }
+
+        // visit it
+        Attitude_State next;
+        step(state, remaining[chosen], next);
+        state = next;
+        order.push_back(remaining[chosen]);
+        remaining[chosen] = remaining.back();
+        remaining.pop_back();
+    }
+}
+
+// estimate the time saved by a move (re-plans the changed range plus the lookahead)
+double Sequence_Optimizer::screen(const std::vector<size_t> &order, const Move &move, std::vector<size_t> &buffer) {
+
+    // build the reordered range
+    buffer.assign(order.begin() + move.first, order.begin() + move.last);
+    if (move.reverse) {std::reverse(buffer.begin(), buffer.end());                                      }
+    else              {std::rotate(buffer.begin(), buffer.begin() + (move.middle - move.first), buffer.end());}
+
+    // re-plan the reordered range, then the unchanged lookahead visits (their attitude chain changes too)
+    size_t stop = std::min(order.size(), move.last + lookahead);
+    Attitude_State state = states[move.first];
+    Attitude_State next;
+    double cost = 0.0;
+    for (size_t target : buffer) {
+        cost += step(state, target, next);
+        state = next;
+    }
+    for (size_t k = move.last; k < stop; k++) {
+        cost += step(state, order[k], next);
+        state = next;
+    }
+
+    // compare with the current cost of the same visits
+    return (prefix_cost[stop] - prefix_cost[move.first]) - cost;
+}
+
+// apply a move to a visiting order
+void Sequence_Optimizer::apply_move(std::vector<size_t> &order, const Move &move) {
+
+    if (move.reverse) {std::reverse(order.begin() + move.first, order.begin() + move.last);                            }
+    else              {std::rotate(order.begin() + move.first, order.begin() + move.middle, order.begin() + move.last);}
+}
+
+// one pass of 2-opt and Or-opt improvement, returns false once no improving move is left
+bool Sequence_Optimizer::improve(std::vector<size_t> &order) {
+
+    size_t n = order.size();
+    if (n < 2) {
+        return false;
+    }
+
+    // best screened move starting at each position
+    std::vector<Move> best(n);
+    for (size_t i = 0; i < n; i++) {
+        best[i] = {true, i, i, i, 0.0};
+    }
+
+    // one scratch buffer per worker thread
+    std::vector<std::vector<size_t>> buffers(thread_count);
+
+    // screen every move that starts at position i
+    parallel_for(pool, n, 8, [&](size_t i, unsigned thread_index) {
+
+        std::vector<size_t> &buffer = buffers[thread_index];
+
+        // keep the move if it beats the best found for this position so far
+        auto consider = [&](Move move) {
+            move.gain = screen(order, move, buffer);
+            if (move.gain > best[i].gain) {
+                best[i] = move;
+            }
+        };
+
+        // 2-opt: reverse the visits [i, j]
+        for (size_t j = i + 1; j < n && j < i + window; j++) {
+            consider({true, i, i, j + 1, 0.0});
+        }
+
+        // Or-opt: move a segment of 1 to 3 visits starting at i later in the order (earlier moves are covered from their new position)
+        for (size_t length = 1; length <= 3 && i + length < n; length++) {
+            for (size_t last = i + length + 1; last <= n && last <= i + length + window; last++) {
+                consider({false, i, i + length, last, 0.0});
+            }
+        }
+
+        // Or-opt: move the segment of 1 to 3 visits that starts right after position i earlier in the order (in front of position first)
+        for (size_t length = 1; length <= 3 && i + 1 + length <= n; length++) {
+            for (size_t first = (i + 1 > window) ? i + 1 - window : 0; first < i + 1; first++) {
+                consider({false, first, i + 1, i + 1 + length, 0.0});
+            }
+        }
+    });
+
+    // collect the improving moves, best first
+    std::vector<Move> moves;
+    for (const Move &move : best) {
+        if (move.gain > 1e-9) {
+            moves.push_back(move);
+        }
+    }
+    if (moves.empty()) {
+        return false;
+    }
+    std::sort(moves.begin(), moves.end(), [](const Move &a, const Move &b) {return a.gain > b.gain;});
+
+    // apply as many moves as possible that don't overlap (including the lookahead each was screened with)
+    double old_cost = prefix_cost[n];
+    std::vector<size_t> old_order = order;
+    std::vector<bool>   touched(n, false);
+    for (const Move &move : moves) {
+        size_t stop = std::min(n, move.last + lookahead);
+        bool overlaps = false;
+        for (size_t k = move.first; k < stop && !overlaps; k++) {
+            overlaps = touched[k];
+        }
+        if (overlaps) {
+            continue;
+        }
+        for (size_t k = move.first; k < stop; k++) {
+            touched[k] = true;
+        }
+        apply_move(order, move);
+    }
+
+    // verify the whole pass by replaying the chain
+    build_prefix(order);
+    if (prefix_cost[n] < old_cost - 1e-9) {
+        return true;
+    }
+
+    // the combined moves didn't pay off, fall back to the best few moves one at a time
+    for (size_t m = 0; m < moves.size() && m < 16; m++) {
+        order = old_order;
+        apply_move(order, moves[m]);
+        build_prefix(order);
+        if (prefix_cost[n] < old_cost - 1e-9) {
+            return true;
+        }
+    }
+
+    // the remaining gains were only screening artifacts, stop here
+    order = old_order;
+    build_prefix(order);
+    return false;
+}
+
+// order the targets to minimize the total reorientation time
+void Sequence_Optimizer::optimize(Sequence_Result &result) {
+
+    // cost of visiting the targets in the order given
+    std::vector<size_t> fifo(targets.size());
+    for (size_t i = 0; i < fifo.size(); i++) {
+        fifo[i] = i;
+    }
+    result.fifo_time = evaluate(fifo);
+
+    // greedy seed
+    nearest_neighbour(result.order);
+    result.seed_time = evaluate(result.order);
+
+    // the seed isn't guaranteed to beat the original order, start from whichever is better
+    if (result.fifo_time < result.seed_time) {
+        result.order = fifo;
+    }
+
+    // improve until no improving move is left
+    build_prefix(result.order);
+    result.passes = 0;
+    while (improve(result.order)) {
+        result.passes++;
+    }
+    result.optimized_time = prefix_cost[result.order.size()];
+}
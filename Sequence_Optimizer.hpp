@@ -0,0 +1,79 @@
+#ifndef SEQUENCE_OPTIMIZER_HPP
+#define SEQUENCE_OPTIMIZER_HPP
+
+#include <vector>
+#include "Ideal_Cube_Sat.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Work_Stealing_Pool.hpp"
+
+// ordered imaging plan produced by the sequence optimizer
+struct Sequence_Result {
+    std::vector<size_t> order; // indices into the target list, in the order they should be visited
+    double fifo_time;          // s (total reorientation time visiting the targets in the order given)
+    double seed_time;          // s (total reorientation time of the nearest neighbour seed order)
+    double optimized_time;     // s (total reorientation time of the optimized order)
+    int    passes;             // number of improvement passes that were accepted
+};
+
+class Sequence_Optimizer {
+
+private:
+
+    // satellite attitude between reorientations (everything the next plan depends on)
+    struct Attitude_State {
+        Attitude attitude; // global to local cartesian coordinates
+        double r;          // current zoom distance
+    };
+
+    // candidate reordering of a contiguous range of the visiting order [first, last)
+    struct Move {
+        bool   reverse; // true for a 2-opt reversal of the range, false for an Or-opt rotation that moves [first, middle) after [middle, last)
+        size_t first;   // first position changed by the move
+        size_t middle;  // split point of an Or-opt rotation (unused by 2-opt)
+        size_t last;    // one past the last position changed by the move
+        double gain;    // s (screened time saved by the move)
+    };
+
+    // cheapest next target found by one worker thread (padded to a cache line so workers don't slow each other down)
+    struct alignas(64) Candidate {
+        double cost;  // s (reorientation time to the target)
+        size_t index; // position of the target in the remaining list
+    };
+
+    const std::vector<Target_Point> &targets; // targets to be sequenced
+    Attitude_State start;                     // satellite attitude before the first target
+    Reaction_Wheel roll_wheel;                // copy of the satellite's roll  reaction wheel
+    Reaction_Wheel pitch_wheel;               // copy of the satellite's pitch reaction wheel
+    Reaction_Wheel yaw_wheel;                 // copy of the satellite's yaw   reaction wheel
+    double zoom_rate;                         // coordinate units/s
+    Planner_Mode planner_mode;                // how the satellite slews between targets
+    Work_Stealing_Pool pool;                  // worker threads used for the searches (kept alive between searches)
+    unsigned thread_count;                    // number of worker threads used for the searches
+    size_t window;                            // max number of positions a single move may span
+    size_t lookahead;                         // number of unchanged visits after a move that are re-planned when screening it
+    std::vector<Attitude_State> states;       // attitude after each visit of the current order (states[k] is after k visits)
+    std::vector<double> prefix_cost;          // s (total time of the first k visits of the current order)
+
+    double step(const Attitude_State &from, size_t target, Attitude_State &to); // plan one reorientation, returns its total time
+
+    double evaluate(const std::vector<size_t> &order); // total time of a visiting order (exact, replays the whole attitude chain)
+
+    void build_prefix(const std::vector<size_t> &order); // recompute states and prefix_cost for a visiting order
+
+    void nearest_neighbour(std::vector<size_t> &order); // greedy seed order (always visit the cheapest next target)
+
+    double screen(const std::vector<size_t> &order, const Move &move, std::vector<size_t> &buffer); // estimate the time saved by a move (re-plans the changed range plus the lookahead)
+
+    void apply_move(std::vector<size_t> &order, const Move &move); // apply a move to a visiting order
+
+    bool improve(std::vector<size_t> &order); // one pass of 2-opt and Or-opt improvement, returns false once no improving move is left
+
+public:
+
+    Sequence_Optimizer(Ideal_Cube_Sat &sat, const std::vector<Target_Point> &targets, unsigned thread_count); // constructor (plans from the satellite's current attitude and hardware)
+
+    void optimize(Sequence_Result &result); // order the targets to minimize the total reorientation time
+
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef SERVER_PROTOCOL_HPP
+#define SERVER_PROTOCOL_HPP
+
+#include <cstdint>
+#include "Telemetry_Format.hpp"
+
+/* Command server wire protocol (little endian, everything fixed size, see Command_Server.hpp)
+    - Every message is one frame: a 12 byte Server_Frame_Header, then length bytes of payload
+    - The client sends requests, the server answers every request with exactly one reply frame of type request | server_reply_flag,
+      with the sequence number of the request, in request order
+    - Plan and Execute carry a Server_Batch_Header and count Server_Target entries, the reply carries count results in the same order
+    - Subscribe carries a uint32_t decimation (stream every Nth physics frame, 0 stops the stream), the reply is empty
+    - State frames (sequence 0) stream one Telemetry_Record of the satellite state in between replies while subscribed,
+      a client that reads too slowly misses frames instead of holding up the satellite
+    - Get_State has no payload, the reply is one Telemetry_Record of the current state
+    - A reply with a nonzero status (Server_Status) has no payload, a frame the server can't parse closes the connection
+*/
+
+// message types (replies set server_reply_flag)
+enum class Server_Message : uint16_t {
+    Plan      = 1, // plan a slew from the current attitude to each target (closed form, the satellite doesn't move)
+    Execute   = 2, // execute a slew to each target in order (the satellite moves, frames are streamed to subscribers)
+    Subscribe = 3, // start, change, or stop the state stream
+    Get_State = 4, // current state
+    State     = 5  // streamed state (server to client only)
+};
+
+// status of a reply
+enum class Server_Status : uint16_t {
+    Ok             = 0, // request done
+    Bad_Request    = 1, // payload doesn't match the message type
+    Unknown_Type   = 2, // message type not supported
+    Too_Many       = 3  // batch larger than server_max_batch
+};
+
+// frame header
+struct Server_Frame_Header {
+    uint32_t length;   // payload bytes after the header
+    uint16_t type;     // Server_Message (with server_reply_flag in replies)
+    uint16_t status;   // Server_Status in replies, zero in requests
+    uint32_t sequence; // chosen by the client, echoed in the reply (zero for streamed state)
+};
+
+// Plan and Execute payload header (followed by count Server_Target entries)
+struct Server_Batch_Header {
+    uint32_t count;    // number of targets
+    uint16_t planner;  // 0 for the server's planner mode, otherwise 1 + Planner_Mode (1 two-step, 2 eigen, 3 concurrent)
+    uint16_t reserved; // zero
+};
+
+// target point (global cartesian coords)
+struct Server_Target {
+    double x;
+    double y;
+    double z;
+};
+
+// one target of a Plan reply
+struct Server_Plan_Result {
+    double   slew_time;          // s
+    double   total_time;         // s (slew and zoom)
+    double   time_saved;         // s (versus the original sequential roll, pitch or yaw, zoom)
+    float    final_attitude[4];  // attitude quaternion after the slew (w, x, y, z), global to local cartesian coords
+    float    peak_saturation[3]; // % (roll, pitch, yaw reaction wheel)
+    uint32_t valid;              // 1 if planned, 0 if the target is not valid (0 0 0 or a non-finite coordinate)
+};
+
+// one target of an Execute reply
+struct Server_Execute_Result {
+    double   slew_time;          // s (shorter than planned only if the satellite braked, never the case for the server)
+    double   total_time;         // s (slew and zoom)
+    double   pointing_error;     // rad (angle between the final focus point and the target point)
+    float    final_attitude[4];  // attitude quaternion after the reorientation (w, x, y, z), global to local cartesian coords
+    float    final_focus[3];     // final focus point (global cartesian coords)
+    float    peak_saturation[3]; // % (roll, pitch, yaw reaction wheel)
+    uint32_t valid;              // 1 if executed, 0 if the target is not valid (0 0 0 or a non-finite coordinate) and was skipped
+    uint32_t reserved;           // zero
+};
+
+static const uint16_t server_reply_flag = 0x8000;  // set in the type of a reply
+static const uint32_t server_max_batch  = 4096;    // most targets in one Plan or Execute request
+static const uint32_t server_max_frame  = sizeof(Server_Batch_Header) + server_max_batch * sizeof(Server_Target); // largest request payload
+
+static_assert(sizeof(Server_Frame_Header)   == 12, "server frame header layout changed");
+static_assert(sizeof(Server_Batch_Header)   == 8 , "server batch header layout changed");
+static_assert(sizeof(Server_Target)         == 24, "server target layout changed");
+static_assert(sizeof(Server_Plan_Result)    == 56, "server plan result layout changed");
+static_assert(sizeof(Server_Execute_Result) == 72, "server execute result layout changed");
+
+#endif
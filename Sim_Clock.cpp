@@ -0,0 +1,137 @@
+#include "Sim_Clock.hpp"
+
+/* Notes:
+    - Wall mode reproduces the original realtime behavior of the simulator
+    - Scaled mode keeps the console refreshing at FPS, but each refresh covers time_scale times as much simulation time
+    - Stepped mode ignores the wall clock entirely, every frame is exactly one frame period of simulation time (useful for headless runs)
+    - Wall and Scaled modes pace frames against absolute deadlines (start + n * frame_period) with sleep_until, so the time spent
+      working in a frame and the sleep granularity never add up into drift
+    - A frame that ends past its deadline doesn't sleep and counts as missed, if it is more than a whole frame late the deadlines
+      restart from now (the lost frames are dropped rather than rushed through)
+*/
+
+// constructor
+Sim_Clock::Sim_Clock(Clock_Mode mode, double time_scale, double FPS):
+
+    // frame statistics measure against the frame period
+    stats(1.0 / FPS)
+
+{
+
+    // store the clock configuration
+    this->mode       = mode;
+    this->time_scale = time_scale;
+    frame_period     = 1.0 / FPS;
+
+    // the session starts now
+    t_start        = std::chrono::steady_clock::now();
+    stepped_time   = 0.0;
+    session_offset = 0.0;
+
+    // start the clock so elapsed() is valid even if start() is never called
+    start();
+}
+
+// restart simulation time at zero
+void Sim_Clock::start() {
+
+    // carry the time since the last start over into the session time
+    session_offset += elapsed();
+
+    // reset both the wall clock reference and the stepped simulation time
+    t_start      = std::chrono::steady_clock::now();
+    stepped_time = 0.0;
+
+    // the first frame ends one frame period from now
+    next_deadline  = t_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(frame_period));
+    last_frame_end = t_start;
+
+    // frame statistics cover one start to the next
+    stats.reset();
+    last_frame_time = 0.0;
+    last_overshoot  = 0.0;
+    last_missed     = false;
+}
+
+// simulation time elapsed since the clock was last started (s)
+double Sim_Clock::elapsed() {
+
+    // stepped clock only advances when a frame ends
+    if (mode == Clock_Mode::Stepped) {
+        return stepped_time;
+    }
+
+    // compute the wall clock time since start
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+    // apply the time warp if the clock is scaled
+    if (mode == Clock_Mode::Scaled) {
+        return t_wall * time_scale;
+    }
+
+    return t_wall;
+}
+
+// simulation time elapsed since the clock was created (s)
+double Sim_Clock::session_time() {
+    return session_offset + elapsed();
+}
+
+// wait for the next frame (sleeps until the frame deadline in Wall and Scaled modes, advances simulation time in Stepped mode)
+void Sim_Clock::end_frame() {
+
+    // stepped clock never sleeps, it just moves simulation time forward by one frame
+    if (mode == Clock_Mode::Stepped) {
+        stepped_time += frame_period;
+        return;
+    }
+
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(frame_period));
+
+    // sleep until the deadline, unless the frame already ran past it
+    auto now = std::chrono::steady_clock::now();
+    last_missed = (now > next_deadline);
+    if (!last_missed) {
+        std::this_thread::sleep_until(next_deadline);
+        now = std::chrono::steady_clock::now();
+        last_overshoot = std::chrono::duration<double>(now - next_deadline).count();
+    } else {
+        last_overshoot = 0.0;
+    }
+
+    // measure the frame
+    last_frame_time = std::chrono::duration<double>(now - last_frame_end).count();
+    last_frame_end  = now;
+    stats.add(last_frame_time, last_overshoot, last_missed);
+
+    // next deadline is one period after this one (restart from now if more than a whole frame behind)
+    next_deadline += period;
+    if (now > next_deadline) {
+        next_deadline = now + period;
+    }
+}
+
+// pacing of the frames since the clock was last started (empty in Stepped mode)
+const Frame_Stats &Sim_Clock::get_frame_stats() {
+    return stats;
+}
+
+// s (wall clock time of the last frame, zero in Stepped mode)
+double Sim_Clock::get_last_frame_time() {
+    return last_frame_time;
+}
+
+// s (how late the last frame's sleep woke up past its deadline)
+double Sim_Clock::get_last_overshoot() {
+    return last_overshoot;
+}
+
+// true if the last frame was already past its deadline when it ended
+bool Sim_Clock::get_last_missed() {
+    return last_missed;
+}
+
+// get the current clock mode
+Clock_Mode Sim_Clock::get_mode() {
+    return mode;
+}
@@ -0,0 +1,56 @@
+#ifndef SIM_CLOCK_HPP
+#define SIM_CLOCK_HPP
+
+#include <chrono>
+#include <thread>
+#include "Frame_Stats.hpp"
+
+// how simulation time advances relative to the wall clock
+enum class Clock_Mode {
+    Wall,   // simulation time follows the wall clock (realtime, original behavior)
+    Scaled, // simulation time runs at a fixed multiple of the wall clock (time warp, e.g. x10 or x1000)
+    Stepped // simulation time advances one fixed frame period per frame and never sleeps (free-running)
+};
+
+class Sim_Clock {
+
+private:
+
+    Clock_Mode mode;                               // how simulation time advances
+    double time_scale;                             // simulation seconds per wall clock second (Scaled mode only)
+    double frame_period;                           // s (wall clock time between frames, also the fixed simulation step in Stepped mode)
+    double stepped_time;                           // s (simulation time accumulated since start in Stepped mode)
+    double session_offset;                         // s (simulation time of all previous starts, so session time never goes backwards)
+    std::chrono::steady_clock::time_point t_start; // wall clock time at which the clock was last started
+    std::chrono::steady_clock::time_point next_deadline;  // wall clock time the current frame should end (Wall and Scaled modes)
+    std::chrono::steady_clock::time_point last_frame_end; // wall clock time the previous frame ended
+    Frame_Stats stats;                             // pacing of the frames since the clock was last started
+    double last_frame_time;                        // s (wall clock time of the last frame)
+    double last_overshoot;                         // s (how late the last frame's sleep woke up past its deadline)
+    bool   last_missed;                            // true if the last frame was already past its deadline when it ended
+
+public:
+
+    Sim_Clock(Clock_Mode mode, double time_scale, double FPS); // constructor
+
+    void start(); // restart simulation time at zero
+
+    double elapsed(); // simulation time elapsed since the clock was last started (s)
+
+    double session_time(); // simulation time elapsed since the clock was created (s)
+
+    void end_frame(); // wait for the next frame (sleeps until the frame deadline in Wall and Scaled modes, advances simulation time in Stepped mode)
+
+    const Frame_Stats &get_frame_stats(); // pacing of the frames since the clock was last started (empty in Stepped mode)
+
+    double get_last_frame_time(); // s (wall clock time of the last frame, zero in Stepped mode)
+
+    double get_last_overshoot(); // s (how late the last frame's sleep woke up past its deadline)
+
+    bool get_last_missed(); // true if the last frame was already past its deadline when it ended
+
+    Clock_Mode get_mode(); // get the current clock mode
+
+};
+
+#endif
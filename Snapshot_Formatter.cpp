@@ -0,0 +1,190 @@
+#include "Snapshot_Formatter.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "Helper_Functions.hpp"
+
+// constructor (empty buffer)
+Snapshot_Formatter::Snapshot_Formatter() {
+    length = 0;
+}
+
+// append a null terminated string
+void Snapshot_Formatter::append(const char *string) {
+    append(string, std::strlen(string));
+}
+
+// append characters
+void Snapshot_Formatter::append(const char *characters, size_t count) {
+
+    // cut off whatever doesn't fit
+    if (count > capacity - length) {
+        count = capacity - length;
+    }
+    std::memcpy(text + length, characters, count);
+    length += count;
+}
+
+// append a fixed point number right aligned in width characters (like printf "%*.*f", without negative zeros)
+void Snapshot_Formatter::append_fixed(double value, int width, int precision) {
+
+    // large enough for any double in fixed notation
+    char number[400];
+    std::to_chars_result result = std::to_chars(number, number + sizeof(number), value, std::chars_format::fixed, precision);
+    char *start = number;
+    char *end   = result.ptr;
+
+    // a negative value that rounds to zero is shown as zero
+    if (*start == '-') {
+        bool all_zero = true;
+        for (char *c = start + 1; c < end; c++) {
+            if (*c != '0' && *c != '.') {
+                all_zero = false;
+                break;
+            }
+        }
+        if (all_zero) {
+            start++;
+        }
+    }
+
+    // pad on the left up to the field width
+    static const char spaces[] = "                                ";
+    int count = static_cast<int>(end - start);
+    if (count < width) {
+        int padding = width - count;
+        append(spaces, static_cast<size_t>(padding < 32 ? padding : 32));
+    }
+    append(start, static_cast<size_t>(count));
+}
+
+// append a number with precision significant digits (like printf "%.*g")
+void Snapshot_Formatter::append_general(double value, int precision) {
+
+    char number[64];
+    std::to_chars_result result = std::to_chars(number, number + sizeof(number), value, std::chars_format::general, precision);
+    append(number, static_cast<size_t>(result.ptr - number));
+}
+
+// append an integer
+void Snapshot_Formatter::append_integer(unsigned long long value) {
+
+    char number[24];
+    std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+    append(number, static_cast<size_t>(result.ptr - number));
+}
+
+// format the console dashboard (rows separated by '\n')
+void Snapshot_Formatter::format_dashboard(const Satellite_Snapshot &snapshot) {
+
+    length = 0;
+
+    // every value field is 7 characters wide with 2 decimals
+    const int width     = 7;
+    const int precision = 2;
+
+    const double rad_to_deg = 180.0 / M_PI;
+
+    // get the currently focused planet string using helper function (shown when there is no target catalog)
+    const char *planet;
+    determine_focused_planet(snapshot.curr_global[0], snapshot.curr_global[1], snapshot.curr_global[2], planet);
+
+    // compose all information (commented out rows are for debugging purposes)
+    append("Target    Focus Point [-]:        X:"); append_fixed(snapshot.targ_global[0], width, precision);
+    append("     Y:");                              append_fixed(snapshot.targ_global[1], width, precision);
+    append("   Z:");                                append_fixed(snapshot.targ_global[2], width, precision); append("\n");
+    append("Sattelite Focus Point [-]:        X:"); append_fixed(snapshot.curr_global[0], width, precision);
+    append("     Y:");                              append_fixed(snapshot.curr_global[1], width, precision);
+    append("   Z:");                                append_fixed(snapshot.curr_global[2], width, precision); append("\n\n");
+    // append("Target    Local Focus Point [-]:  X:"); append_fixed(snapshot.targ_local[0], width, precision);
+    // append("     Y:");                              append_fixed(snapshot.targ_local[1], width, precision);
+    // append("   Z:");                                append_fixed(snapshot.targ_local[2], width, precision); append("\n");
+    // append("Sattelite Local Focus Point [-]:  X:"); append_fixed(snapshot.curr_local[0], width, precision);
+    // append("     Y:");                              append_fixed(snapshot.curr_local[1], width, precision);
+    // append("   Z:");                                append_fixed(snapshot.curr_local[2], width, precision); append("\n\n");
+    // append("Target    Spherical Coords [-]:   R:"); append_fixed(snapshot.targ_spherical[0], width, precision);
+    // append(" Theta:");                              append_fixed(snapshot.targ_spherical[1] * rad_to_deg, width, precision);
+    // append(" Phi:");                                append_fixed(snapshot.targ_spherical[2] * rad_to_deg, width, precision); append("\n");
+    // append("Sattelite Spherical Coords [-]:   R:"); append_fixed(snapshot.curr_spherical[0], width, precision);
+    // append(" Theta:");                              append_fixed(snapshot.curr_spherical[1] * rad_to_deg, width, precision);
+    // append(" Phi:");                                append_fixed(snapshot.curr_spherical[2] * rad_to_deg, width, precision); append("\n\n");
+    append("Sat. Angular Velocity [deg/s]: Roll:"); append_fixed(snapshot.omega_roll * rad_to_deg, width, precision);
+    append(" Pitch:");                              append_fixed(snapshot.omega_pitch * rad_to_deg, width, precision);
+    append(" Yaw:");                                append_fixed(snapshot.omega_yaw * rad_to_deg, width, precision); append("\n");
+    append("Reaction Wheel Saturation [%]: Roll:"); append_fixed(snapshot.saturation_roll, width, precision);
+    append(" Pitch:");                              append_fixed(snapshot.saturation_pitch, width, precision);
+    append(" Yaw:");                                append_fixed(snapshot.saturation_yaw, width, precision); append("\n\n");
+    append("Optical Zoom Distance [-]: ");          append_fixed(snapshot.zoom_dist, 0, precision); append("\n\n");
+    if (snapshot.catalog_name[0] != '\0') {
+        append("Nearest Catalog Target: ");         append(snapshot.catalog_name);
+        append(" (");                               append_fixed(snapshot.catalog_angle * rad_to_deg, 0, precision); append(" deg off focus)\n\n");
+    } else {
+        append("Planet in Current Focused Octant: "); append(planet); append("\n\n");
+    }
+    if (snapshot.message[0] != '\0') {
+        append(snapshot.message); append("\n\n");
+    }
+
+    // frame pacing of the maneuver in progress (realtime clocks only)
+    if (snapshot.frames_timed > 0) {
+        append("Frame Pacing [ms]: p50 ");          append_fixed(1e3 * snapshot.frame_p50, 0, precision);
+        append("  p99 ");                           append_fixed(1e3 * snapshot.frame_p99, 0, precision);
+        append("  jitter p99 ");                    append_fixed(1e3 * snapshot.jitter_p99, 0, precision);
+        append("  overshoot max ");                 append_fixed(1e3 * snapshot.overshoot_max, 0, precision);
+        append("  missed ");                        append_integer(snapshot.frames_missed);
+        append("/");                                append_integer(snapshot.frames_timed); append("\n");
+    }
+}
+
+// format the header row of the telemetry CSV (ends in '\n')
+void Snapshot_Formatter::format_csv_header() {
+
+    length = 0;
+    append("frame,sim_time,targ_x,targ_y,targ_z,curr_x,curr_y,curr_z,curr_r,curr_theta_deg,curr_phi_deg,"
+           "q_w,q_x,q_y,q_z,omega_roll_dps,omega_pitch_dps,omega_yaw_dps,sat_roll,sat_pitch,sat_yaw,zoom,frame_time_ms,overshoot_ms,missed_deadline\n");
+}
+
+// format one row of the telemetry CSV (angles and rates in degrees, times in ms, ends in '\n')
+void Snapshot_Formatter::format_csv_row(const Satellite_Snapshot &snapshot) {
+
+    length = 0;
+
+    const double rad_to_deg = 180.0 / M_PI;
+
+    append_integer(snapshot.frame);                                append(",");
+    append_fixed(snapshot.sim_time, 0, 6);                         append(",");
+    append_general(snapshot.targ_global[0], 6);                    append(",");
+    append_general(snapshot.targ_global[1], 6);                    append(",");
+    append_general(snapshot.targ_global[2], 6);                    append(",");
+    append_general(snapshot.curr_global[0], 6);                    append(",");
+    append_general(snapshot.curr_global[1], 6);                    append(",");
+    append_general(snapshot.curr_global[2], 6);                    append(",");
+    append_general(snapshot.curr_spherical[0], 6);                 append(",");
+    append_general(snapshot.curr_spherical[1] * rad_to_deg, 6);    append(",");
+    append_general(snapshot.curr_spherical[2] * rad_to_deg, 6);    append(",");
+    append_general(snapshot.attitude.w, 7);                        append(",");
+    append_general(snapshot.attitude.x, 7);                        append(",");
+    append_general(snapshot.attitude.y, 7);                        append(",");
+    append_general(snapshot.attitude.z, 7);                        append(",");
+    append_general(snapshot.omega_roll  * rad_to_deg, 6);          append(",");
+    append_general(snapshot.omega_pitch * rad_to_deg, 6);          append(",");
+    append_general(snapshot.omega_yaw   * rad_to_deg, 6);          append(",");
+    append_fixed(snapshot.saturation_roll , 0, 4);                 append(",");
+    append_fixed(snapshot.saturation_pitch, 0, 4);                 append(",");
+    append_fixed(snapshot.saturation_yaw  , 0, 4);                 append(",");
+    append_general(snapshot.zoom_dist, 6);                         append(",");
+    append_fixed(1e3 * snapshot.frame_time, 0, 4);                 append(",");
+    append_fixed(1e3 * snapshot.sleep_overshoot, 0, 4);            append(",");
+    append_integer(snapshot.missed_deadline ? 1 : 0);              append("\n");
+}
+
+// formatted text (not null terminated)
+const char *Snapshot_Formatter::data() const {
+    return text;
+}
+
+// characters of formatted text
+size_t Snapshot_Formatter::size() const {
+    return length;
+}
@@ -0,0 +1,51 @@
+#ifndef SNAPSHOT_FORMATTER_HPP
+#define SNAPSHOT_FORMATTER_HPP
+
+#include <cstddef>
+#include "Satellite_Snapshot.hpp"
+
+/* Formats satellite snapshots as text into a preallocated character buffer
+    - Numbers go through std::to_chars (no locale, no streams, no allocation), fixed point output never shows a negative zero
+    - The same formatter renders the console dashboard and the telemetry CSV rows, so a frame is formatted once per output
+      and the cost of formatting can be benchmarked on its own
+    - Text that doesn't fit in the buffer is cut off (the buffer is far larger than any dashboard or CSV row)
+*/
+
+class Snapshot_Formatter {
+
+public:
+
+    static const size_t capacity = 2048; // characters in the buffer
+
+private:
+
+    char   text[capacity]; // formatted text (not null terminated)
+    size_t length;         // characters of formatted text
+
+    void append(const char *string); // append a null terminated string
+
+    void append(const char *characters, size_t count); // append characters
+
+    void append_fixed(double value, int width, int precision); // append a fixed point number right aligned in width characters (like printf "%*.*f", without negative zeros)
+
+    void append_general(double value, int precision); // append a number with precision significant digits (like printf "%.*g")
+
+    void append_integer(unsigned long long value); // append an integer
+
+public:
+
+    Snapshot_Formatter(); // constructor (empty buffer)
+
+    void format_dashboard(const Satellite_Snapshot &snapshot); // format the console dashboard (rows separated by '\n')
+
+    void format_csv_header(); // format the header row of the telemetry CSV (ends in '\n')
+
+    void format_csv_row(const Satellite_Snapshot &snapshot); // format one row of the telemetry CSV (angles and rates in degrees, times in ms, ends in '\n')
+
+    const char *data() const; // formatted text (not null terminated)
+
+    size_t size() const; // characters of formatted text
+
+};
+
+#endif
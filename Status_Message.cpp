@@ -0,0 +1,41 @@
+#include "Status_Message.hpp"
+
+#include <cstddef>
+
+// text of every status message, in code order
+static const char *const status_texts[] = {
+    "",
+    "Welcome to the Ideal Cube Satellite Simulator!",
+
+    "Executing Roll Maneuver:",       "Executing Roll Maneuver: Accelerating...",       "Executing Roll Maneuver: Coasting...",       "Executing Roll Maneuver: Decelerating...",       "Executing Roll Maneuver: Complete",
+    "Executing Pitch Maneuver:",      "Executing Pitch Maneuver: Accelerating...",      "Executing Pitch Maneuver: Coasting...",      "Executing Pitch Maneuver: Decelerating...",      "Executing Pitch Maneuver: Complete",
+    "Executing Yaw Maneuver:",        "Executing Yaw Maneuver: Accelerating...",        "Executing Yaw Maneuver: Coasting...",        "Executing Yaw Maneuver: Decelerating...",        "Executing Yaw Maneuver: Complete",
+    "Executing Eigen-Axis Maneuver:", "Executing Eigen-Axis Maneuver: Accelerating...", "Executing Eigen-Axis Maneuver: Coasting...", "Executing Eigen-Axis Maneuver: Decelerating...", "Executing Eigen-Axis Maneuver: Complete",
+
+    "Executing Concurrent Roll/Pitch/Zoom Maneuver:", "Executing Concurrent Roll/Pitch/Zoom Maneuver: In Progress...", "Executing Concurrent Roll/Pitch/Zoom Maneuver: Complete",
+    "Executing Concurrent Roll/Yaw/Zoom Maneuver:",   "Executing Concurrent Roll/Yaw/Zoom Maneuver: In Progress...",   "Executing Concurrent Roll/Yaw/Zoom Maneuver: Complete",
+
+    "Adjusting Optical Zoom...",
+    "Optical Zoom Complete",
+
+    "New Target Received: Braking..."
+};
+
+static_assert(sizeof(status_texts) / sizeof(status_texts[0]) == static_cast<size_t>(Status_Message::Count), "every status message needs a text");
+
+// text of a status message (empty string for None or an unknown code)
+const char *status_text(Status_Message message) {
+
+    // codes come back from telemetry files too, so don't trust them
+    size_t index = static_cast<size_t>(message);
+    return (index < static_cast<size_t>(Status_Message::Count)) ? status_texts[index] : "";
+}
+
+// status message of a single maneuver phase
+Status_Message maneuver_status(Maneuver_Type maneuver, Maneuver_Phase phase) {
+
+    // each maneuver type has one message per phase, in phase order
+    const int phases = 5;
+    int index = static_cast<int>(Status_Message::Roll_Starting) + phases * static_cast<int>(maneuver) + static_cast<int>(phase);
+    return static_cast<Status_Message>(index);
+}
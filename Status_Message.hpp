@@ -0,0 +1,53 @@
+#ifndef STATUS_MESSAGE_HPP
+#define STATUS_MESSAGE_HPP
+
+#include <cstdint>
+
+/* Console status messages
+    - Every message the satellite shows is a code into a static text table, so frames never build strings
+    - The code is what goes into the telemetry stream (Telemetry_Record::status), codes are never renumbered, only added at the end
+*/
+
+// kind of maneuver being executed by Ideal_Cube_Sat::execute_maneuver
+enum class Maneuver_Type {
+    Roll,      // rotation about +z axis
+    Pitch,     // rotation about +x axis
+    Yaw,       // rotation about +y axis
+    Eigen_Axis // single rotation about an arbitrary axis
+};
+
+// phase of a maneuver
+enum class Maneuver_Phase {
+    Starting,     // start message is held on screen
+    Accelerating, // reaction wheel spinning up
+    Coasting,     // constant angular velocity
+    Decelerating, // reaction wheel spinning down
+    Complete      // final state, end message is held on screen
+};
+
+// status message codes (index into the text table)
+enum class Status_Message : uint16_t {
+    None = 0,                  // no message
+    Welcome,                   // program start
+
+    Roll_Starting,       Roll_Accelerating,       Roll_Coasting,       Roll_Decelerating,       Roll_Complete,
+    Pitch_Starting,      Pitch_Accelerating,      Pitch_Coasting,      Pitch_Decelerating,      Pitch_Complete,
+    Yaw_Starting,        Yaw_Accelerating,        Yaw_Coasting,        Yaw_Decelerating,        Yaw_Complete,
+    Eigen_Axis_Starting, Eigen_Axis_Accelerating, Eigen_Axis_Coasting, Eigen_Axis_Decelerating, Eigen_Axis_Complete,
+
+    Concurrent_Pitch_Starting, Concurrent_Pitch_In_Progress, Concurrent_Pitch_Complete,
+    Concurrent_Yaw_Starting,   Concurrent_Yaw_In_Progress,   Concurrent_Yaw_Complete,
+
+    Zoom_Adjusting,            // optical zoom in progress
+    Zoom_Complete,             // optical zoom done
+
+    Retargeting,               // new target received mid-maneuver, braking to a stop before slewing to it
+
+    Count                      // number of codes (not a message)
+};
+
+const char *status_text(Status_Message message); // text of a status message (empty string for None or an unknown code)
+
+Status_Message maneuver_status(Maneuver_Type maneuver, Maneuver_Phase phase); // status message of a single maneuver phase
+
+#endif
@@ -0,0 +1,252 @@
+#include "Target_Catalog.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include "Target_File_Reader.hpp"
+
+// constructor (empty catalog)
+Target_Catalog::Target_Catalog() {
+    indexed = true;
+}
+
+// add every target in a catalog file ("X Y Z name" lines, see Target_File_Reader) and build the index, returns false if the file can't be opened
+bool Target_Catalog::load(const char *path) {
+
+    Target_File_Reader reader(path);
+    if (!reader.is_open()) {
+        return false;
+    }
+
+    double x, y, z;
+    const char *name;
+    size_t name_length;
+    while (reader.next(x, y, z, name, name_length)) {
+        add(x, y, z, name, name_length);
+    }
+
+    build_index();
+    return true;
+}
+
+// add a target (global cartesian coords, any distance), build_index() must run before the next lookup
+void Target_Catalog::add(double x, double y, double z, const char *name, size_t name_length) {
+
+    // store the direction only
+    double length = sqrt(x * x + y * y + z * z);
+    if (length == 0.0) {
+        return;
+    }
+    Entry entry;
+    entry.x    = static_cast<float>(x / length);
+    entry.y    = static_cast<float>(y / length);
+    entry.z    = static_cast<float>(z / length);
+    entry.name = static_cast<uint32_t>(names.size());
+    entry.load_index = static_cast<uint32_t>(entries.size());
+
+    // unnamed targets are named after their position in the catalog
+    char number[32];
+    if (name_length == 0) {
+        name_length = static_cast<size_t>(std::snprintf(number, sizeof(number), "Target %zu", entries.size() + 1));
+        name = number;
+    }
+    names.insert(names.end(), name, name + name_length);
+    names.push_back('\0');
+
+    entries.push_back(entry);
+    indexed = false;
+}
+
+// build the direction index over every target added so far
+void Target_Catalog::build_index() {
+    split_axis.assign(entries.size(), 0);
+    build(0, entries.size());
+    indexed = true;
+}
+
+// build the subtree of a range of entries
+void Target_Catalog::build(size_t begin, size_t end) {
+
+    if (end - begin <= leaf_size) {
+        return;
+    }
+
+    // split along the axis the range is spread out the most
+    float low[3]  = { 2.0f,  2.0f,  2.0f};
+    float high[3] = {-2.0f, -2.0f, -2.0f};
+    for (size_t i = begin; i < end; i++) {
+        const float p[3] = {entries[i].x, entries[i].y, entries[i].z};
+        for (int axis = 0; axis < 3; axis++) {
+            low[axis]  = std::min(low[axis] , p[axis]);
+            high[axis] = std::max(high[axis], p[axis]);
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis]) {
+            axis = a;
+        }
+    }
+
+    // the median goes in the middle, smaller coords before it, larger after it (it isn't part of either half, so it never moves again)
+    size_t middle = begin + (end - begin) / 2;
+    auto coord = [axis](const Entry &e) { return (axis == 0) ? e.x : (axis == 1) ? e.y : e.z; };
+    std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end,
+                     [&coord](const Entry &a, const Entry &b) { return coord(a) < coord(b); });
+    split_axis[middle] = static_cast<uint8_t>(axis);
+
+    build(begin, middle);
+    build(middle + 1, end);
+}
+
+// search the subtree of a range of entries for anything closer than best_distance (squared)
+void Target_Catalog::search(size_t begin, size_t end, const float query[3], float &best_distance, size_t &best) const {
+
+    // leaves are scanned
+    if (end - begin <= leaf_size) {
+        for (size_t i = begin; i < end; i++) {
+            float dx = entries[i].x - query[0];
+            float dy = entries[i].y - query[1];
+            float dz = entries[i].z - query[2];
+            float distance = dx * dx + dy * dy + dz * dz;
+            if (distance < best_distance) {
+                best_distance = distance;
+                best          = i;
+            }
+        }
+        return;
+    }
+
+    // the median itself
+    size_t middle = begin + (end - begin) / 2;
+    const Entry &m = entries[middle];
+    float dx = m.x - query[0];
+    float dy = m.y - query[1];
+    float dz = m.z - query[2];
+    float distance = dx * dx + dy * dy + dz * dz;
+    if (distance < best_distance) {
+        best_distance = distance;
+        best          = middle;
+    }
+
+    // the query's side of the split first, the other side only if the split plane is closer than the best so far
+    int   axis   = split_axis[middle];
+    float offset = query[axis] - ((axis == 0) ? m.x : (axis == 1) ? m.y : m.z);
+    if (offset < 0.0f) {
+        search(begin, middle, query, best_distance, best);
+        if (offset * offset < best_distance) {
+            search(middle + 1, end, query, best_distance, best);
+        }
+    } else {
+        search(middle + 1, end, query, best_distance, best);
+        if (offset * offset < best_distance) {
+            search(begin, middle, query, best_distance, best);
+        }
+    }
+}
+
+// add every entry of the subtree of a range of entries within max_distance (squared)
+void Target_Catalog::search_within(size_t begin, size_t end, const float query[3], float max_distance, std::vector<size_t> &indices) const {
+
+    // leaves are scanned
+    if (end - begin <= leaf_size) {
+        for (size_t i = begin; i < end; i++) {
+            float dx = entries[i].x - query[0];
+            float dy = entries[i].y - query[1];
+            float dz = entries[i].z - query[2];
+            if (dx * dx + dy * dy + dz * dz <= max_distance) {
+                indices.push_back(i);
+            }
+        }
+        return;
+    }
+
+    // the median itself
+    size_t middle = begin + (end - begin) / 2;
+    const Entry &m = entries[middle];
+    float dx = m.x - query[0];
+    float dy = m.y - query[1];
+    float dz = m.z - query[2];
+    if (dx * dx + dy * dy + dz * dz <= max_distance) {
+        indices.push_back(middle);
+    }
+
+    // each half only if the ball reaches across the split plane
+    int   axis   = split_axis[middle];
+    float offset = query[axis] - ((axis == 0) ? m.x : (axis == 1) ? m.y : m.z);
+    if (offset <= 0.0f || offset * offset <= max_distance) {
+        search_within(begin, middle, query, max_distance, indices);
+    }
+    if (offset >= 0.0f || offset * offset <= max_distance) {
+        search_within(middle + 1, end, query, max_distance, indices);
+    }
+}
+
+// number of targets
+size_t Target_Catalog::size() const {
+    return entries.size();
+}
+
+// nearest target to a direction (global cartesian coords, any length) and its angle from it (rad), returns false if the catalog is empty
+bool Target_Catalog::nearest(double x, double y, double z, size_t &index, double &angle) const {
+
+    double length = sqrt(x * x + y * y + z * z);
+    if (entries.empty() || length == 0.0) {
+        return false;
+    }
+    if (!indexed) {
+        std::cerr << "ERROR: Target catalog lookup before Target_Catalog::build_index()" << std::endl;
+        return false;
+    }
+
+    // search with the unit direction
+    const float query[3] = {static_cast<float>(x / length), static_cast<float>(y / length), static_cast<float>(z / length)};
+    float  best_distance = 5.0f; // (larger than any squared distance between unit vectors)
+    size_t best          = 0;
+    search(0, entries.size(), query, best_distance, best);
+
+    // straight line distance between unit vectors to angle
+    index = best;
+    angle = 2.0 * asin(std::min(1.0, sqrt(static_cast<double>(best_distance)) / 2.0));
+    return true;
+}
+
+// every target within an angle (rad) of a direction (global cartesian coords, any length), replaces the contents of indices (in index order)
+void Target_Catalog::within(double x, double y, double z, double angle, std::vector<size_t> &indices) const {
+
+    indices.clear();
+    double length = sqrt(x * x + y * y + z * z);
+    if (entries.empty() || length == 0.0 || angle < 0.0) {
+        return;
+    }
+    if (!indexed) {
+        std::cerr << "ERROR: Target catalog lookup before Target_Catalog::build_index()" << std::endl;
+        return;
+    }
+
+    // angle to straight line distance between unit vectors (every target is within half a turn)
+    double chord = (angle >= M_PI) ? 2.0 : 2.0 * sin(angle / 2.0);
+    const float query[3] = {static_cast<float>(x / length), static_cast<float>(y / length), static_cast<float>(z / length)};
+    search_within(0, entries.size(), query, static_cast<float>(chord * chord), indices);
+
+    // tree order means nothing outside the catalog, index order makes results easy to merge
+    std::sort(indices.begin(), indices.end());
+}
+
+// name of a target
+const char *Target_Catalog::get_name(size_t index) const {
+    return &names[entries[index].name];
+}
+
+// position a target was added at (zero based, the order of the catalog file's valid lines, unlike index it doesn't depend on the tree)
+size_t Target_Catalog::get_load_index(size_t index) const {
+    return entries[index].load_index;
+}
+
+// unit direction of a target (global cartesian coords)
+void Target_Catalog::get_direction(size_t index, double &x, double &y, double &z) const {
+    x = entries[index].x;
+    y = entries[index].y;
+    z = entries[index].z;
+}
@@ -0,0 +1,67 @@
+#ifndef TARGET_CATALOG_HPP
+#define TARGET_CATALOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Catalog of named targets indexed by direction
+    - Targets are stored as unit directions from the satellite (distance doesn't matter for what the boresight points at)
+    - The index is a k-d tree over the unit vectors, laid out implicitly in one array: the entries of every subtree are contiguous,
+      each split is at the median of its range (which sits between the two halves), and ranges of 8 or fewer entries are scanned as leaves (no node pointers at all)
+    - The nearest target by angle is the nearest by straight line distance between unit vectors, so the search prunes with plain
+      squared distances and only converts the winner to an angle (a cone of directions is a ball of unit vectors the same way)
+    - Entries are 20 bytes (float direction, the offset of the name in one shared name pool, and the position the target was added at),
+      a million targets take about 20 MB plus names
+    - Lookups return positions in tree order (only meaningful to this catalog's getters), get_load_index() gives the stable position to report
+*/
+
+class Target_Catalog {
+
+private:
+
+    // one target (unit direction, where its name starts in the name pool, and the order it was added in)
+    struct Entry {
+        float x, y, z;
+        uint32_t name;
+        uint32_t load_index;
+    };
+
+    static const size_t leaf_size = 8; // ranges this small are scanned instead of split
+
+    std::vector<Entry>   entries;    // targets in k-d tree order (after build_index)
+    std::vector<uint8_t> split_axis; // split axis (0, 1, 2 for x, y, z) of the range whose median is at this index
+    std::vector<char>    names;      // null terminated target names, back to back
+    bool indexed;                    // true once build_index() has run on all the entries
+
+    void build(size_t begin, size_t end); // build the subtree of a range of entries
+
+    void search(size_t begin, size_t end, const float query[3], float &best_distance, size_t &best) const; // search the subtree of a range of entries for anything closer than best_distance (squared)
+
+    void search_within(size_t begin, size_t end, const float query[3], float max_distance, std::vector<size_t> &indices) const; // add every entry of the subtree of a range of entries within max_distance (squared)
+
+public:
+
+    Target_Catalog(); // constructor (empty catalog)
+
+    bool load(const char *path); // add every target in a catalog file ("X Y Z name" lines, see Target_File_Reader) and build the index, returns false if the file can't be opened
+
+    void add(double x, double y, double z, const char *name, size_t name_length); // add a target (global cartesian coords, any distance), build_index() must run before the next lookup
+
+    void build_index(); // build the direction index over every target added so far
+
+    size_t size() const; // number of targets
+
+    bool nearest(double x, double y, double z, size_t &index, double &angle) const; // nearest target to a direction (global cartesian coords, any length) and its angle from it (rad), returns false if the catalog is empty
+
+    void within(double x, double y, double z, double angle, std::vector<size_t> &indices) const; // every target within an angle (rad) of a direction (global cartesian coords, any length), replaces the contents of indices (in index order)
+
+    const char *get_name(size_t index) const; // name of a target
+
+    size_t get_load_index(size_t index) const; // position a target was added at (zero based, the order of the catalog file's valid lines, unlike index it doesn't depend on the tree)
+
+    void get_direction(size_t index, double &x, double &y, double &z) const; // unit direction of a target (global cartesian coords)
+
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "Target_File_Reader.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// skip delimiters (spaces, tabs, commas, carriage returns) within a line
+static const char *skip_delimiters(const char *p, const char *line_end) {
+
+    while (p < line_end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+// parse one number from a line, returns nullptr if there is no valid finite number at p
+static const char *parse_number(const char *p, const char *line_end, double &value) {
+
+    // from_chars doesn't accept an explicit leading plus sign, so skip it here
+    if (p < line_end && *p == '+') {
+        p++;
+    }
+
+    // parse the number without any locale or stream overhead (from_chars also takes "inf" and "nan", which are no coordinate, same rule as console input)
+    std::from_chars_result result = std::from_chars(p, line_end, value);
+    if (result.ec != std::errc() || !std::isfinite(value)) {
+        return nullptr;
+    }
+    return result.ptr;
+}
+
+// constructor (maps the target file)
+Target_File_Reader::Target_File_Reader(const char *path) : file(path) {
+
+    // start reading from the beginning of the file
+    cursor        = file.data();
+    end           = file.data() + file.size();
+    line_number   = 0;
+    invalid_lines = 0;
+}
+
+// true if the target file was opened successfully
+bool Target_File_Reader::is_open() {
+    return file.is_open();
+}
+
+// read the next valid target point, returns false at the end of the file
+bool Target_File_Reader::next(double &x, double &y, double &z) {
+
+    const char *name;
+    size_t name_length;
+    return read(x, y, z, name, name_length, false);
+}
+
+// read the next valid target point and its name (empty if the line has none, points into the mapping), returns false at the end of the file
+bool Target_File_Reader::next(double &x, double &y, double &z, const char *&name, size_t &name_length) {
+    return read(x, y, z, name, name_length, true);
+}
+
+// read the next valid line, returns false at the end of the file
+bool Target_File_Reader::read(double &x, double &y, double &z, const char *&name, size_t &name_length, bool allow_name) {
+
+    // keep reading lines until a valid target is found or the file ends
+    while (cursor != nullptr && cursor < end) {
+
+        // find the end of the current line and move the cursor past it
+        const char *line_start = cursor;
+        const char *line_end   = static_cast<const char *>(std::memchr(line_start, '\n', end - line_start));
+        if (line_end == nullptr) {line_end = end;}
+        cursor = line_end + 1;
+        line_number++;
+
+        // skip blank lines and comments
+        const char *p = skip_delimiters(line_start, line_end);
+        if (p == line_end || *p == '#') {
+            continue;
+        }
+
+        // parse exactly 3 numbers from the line
+        double coords[3];
+        int    count = 0;
+        while (p != nullptr && p < line_end && count < 3) {
+            p = parse_number(p, line_end, coords[count]);
+            if (p != nullptr) {
+                p = skip_delimiters(p, line_end);
+                count++;
+            }
+        }
+
+        // the rest of the line is the name, if names are allowed (trailing whitespace trimmed)
+        name        = line_end;
+        name_length = 0;
+        if (allow_name && p != nullptr && count == 3 && p < line_end) {
+            const char *name_end = line_end;
+            while (name_end > p && (name_end[-1] == ' ' || name_end[-1] == '\t' || name_end[-1] == '\r')) {
+                name_end--;
+            }
+            name        = p;
+            name_length = static_cast<size_t>(name_end - p);
+            p           = line_end;
+        }
+
+        // reject malformed lines and the origin (same rules as console input)
+        if (p == nullptr || p != line_end || count != 3 || (coords[0] == 0.0 && coords[1] == 0.0 && coords[2] == 0.0)) {
+
+            // only report the first few so a badly formatted file doesn't flood the console
+            if (invalid_lines < 10) {
+                std::cerr << "Skipping invalid target on line " << line_number << std::endl;
+            }
+            invalid_lines++;
+            continue;
+        }
+
+        // valid target found
+        x = coords[0];
+        y = coords[1];
+        z = coords[2];
+        return true;
+    }
+
+    // reached the end of the file
+    return false;
+}
+
+// number of lines skipped so far because they were not valid target points
+size_t Target_File_Reader::get_invalid_lines() {
+    return invalid_lines;
+}
@@ -0,0 +1,40 @@
+#ifndef TARGET_FILE_READER_HPP
+#define TARGET_FILE_READER_HPP
+
+#include <cstddef>
+#include "Mapped_File.hpp"
+
+/* Target file format:
+    - one target point per line as 3 signed numbers in global cartesian coords "X Y Z" (space, tab, or comma delimited)
+    - blank lines and lines starting with '#' are ignored
+    - lines that don't hold exactly 3 numbers, and the origin ("0 0 0"), are skipped and counted as invalid
+    - catalog files (see Target_Catalog) may follow the 3 numbers with a target name, which runs to the end of the line
+*/
+
+class Target_File_Reader {
+
+private:
+
+    Mapped_File file;     // memory mapped target file
+    const char *cursor;   // start of the next unread line
+    const char *end;      // end of the mapped file contents
+    size_t line_number;   // line number of the last line read (1 based)
+    size_t invalid_lines; // number of lines skipped because they were not valid target points
+
+    bool read(double &x, double &y, double &z, const char *&name, size_t &name_length, bool allow_name); // read the next valid line, returns false at the end of the file
+
+public:
+
+    Target_File_Reader(const char *path); // constructor (maps the target file)
+
+    bool is_open(); // true if the target file was opened successfully
+
+    bool next(double &x, double &y, double &z); // read the next valid target point, returns false at the end of the file
+
+    bool next(double &x, double &y, double &z, const char *&name, size_t &name_length); // read the next valid target point and its name (empty if the line has none, points into the mapping), returns false at the end of the file
+
+    size_t get_invalid_lines(); // number of lines skipped so far because they were not valid target points
+
+};
+
+#endif
@@ -0,0 +1,420 @@
+#include "Task_Allocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+// constructor (identity attitude, zoom distance 1, idle)
+Task_Allocator::Satellite::Satellite(const Satellite_Config &config):
+
+    // every satellite carries its own wheels (identical here, but scoring never assumes so)
+    roll_wheel( config.get_inertia(), config.max_torque, config.max_angular_momentum),
+    pitch_wheel(config.get_inertia(), config.max_torque, config.max_angular_momentum),
+    yaw_wheel(  config.get_inertia(), config.max_torque, config.max_angular_momentum),
+    zoom_rate(config.zoom_rate),
+
+    // same starting point as Ideal_Cube_Sat (focus point at (0, 0, 1))
+    attitude(),
+    r(1.0),
+    free_time(0.0),
+
+    // nothing to bid on yet
+    best(0),
+    best_time(0.0)
+
+{
+}
+
+// attitude after the last queued target
+const Attitude &Task_Allocator::Satellite::tail_attitude() const {
+    return queue.empty() ? attitude : queue.back().attitude;
+}
+
+// zoom distance after the last queued target
+double Task_Allocator::Satellite::tail_r() const {
+    return queue.empty() ? r : queue.back().r;
+}
+
+// s (when the satellite can start another target)
+double Task_Allocator::Satellite::tail_time(double now) const {
+    return queue.empty() ? std::max(free_time, now) : queue.back().end;
+}
+
+// constructor (identical satellites, zero threads means one per core)
+Task_Allocator::Task_Allocator(size_t satellite_count, const Satellite_Config &config, Allocation_Mode mode, Planner_Mode planner_mode, unsigned thread_count,
+                               double horizon, double time_to_live, size_t window):
+
+    // start the scoring threads once, they sleep between calls
+    pool(thread_count),
+
+    // allocation settings
+    mode(mode),
+    planner_mode(planner_mode),
+    horizon(horizon),
+    time_to_live(time_to_live),
+    window(std::max<size_t>(window, 1)),
+    chunk_size(256),
+
+    // fleet starts idle
+    satellites(satellite_count, Satellite(config)),
+
+    // nothing submitted yet
+    remaining(0),
+    now(0.0),
+    stats()
+
+{
+    // the per-call buffers are sized for a full window up front
+    candidates.reserve(this->window);
+    taken.reserve(this->window);
+    bids.reserve(this->window);
+    costs.reserve(satellite_count * this->window);
+}
+
+// add a target to the stream (global cartesian coords, arrival times never decrease), returns false if the point is not valid
+bool Task_Allocator::submit(double x, double y, double z, double arrival) {
+
+    // the origin and non-finite points have no direction, so they can't be pointed at (same rule as Ideal_Cube_Sat::set_target)
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z) || (x == 0.0 && y == 0.0 && z == 0.0)) {
+        return false;
+    }
+
+    Target_Point target;
+    target.x = x;
+    target.y = y;
+    target.z = z;
+    backlog.push_back(targets.size());
+    targets.push_back(target);
+    arrivals.push_back(arrival);
+    owner.push_back(-1);
+    stats.submitted++;
+    return true;
+}
+
+// commit what has started by now, then (re)assign the waiting targets to the fleet up to the horizon
+void Task_Allocator::allocate(double now) {
+
+    auto t_wall_start = std::chrono::steady_clock::now();
+    this->now = now;
+
+    // queued targets that haven't started go back to the backlog, then the stale ones are dropped
+    commit(now);
+    expire(now);
+
+    // the oldest targets are the candidates of this call
+    size_t count = std::min(window, backlog.size());
+    candidates.assign(backlog.begin(), backlog.begin() + static_cast<std::ptrdiff_t>(count));
+    taken.assign(count, 0);
+    bids.assign(count, satellites.size());
+    costs.resize(satellites.size() * count);
+    remaining = count;
+
+    // plan the rows of every satellite that has room in its queue
+    rows.clear();
+    for (size_t s = 0; s < satellites.size(); s++) {
+        if (has_room(s)) {
+            rows.push_back(s);
+        } else {
+            satellites[s].best = count;
+        }
+    }
+    score_rows();
+
+    // match satellites and candidates
+    if (mode == Allocation_Mode::Greedy) {
+        greedy();
+    } else {
+        auction();
+    }
+
+    // the assigned candidates leave the backlog (the rest keep their place)
+    size_t kept = 0;
+    for (size_t i = 0; i < backlog.size(); i++) {
+        if (i >= count || !taken[i]) {
+            backlog[kept++] = backlog[i];
+        }
+    }
+    backlog.resize(kept);
+
+    double t_wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_wall_start).count();
+    stats.calls++;
+    stats.allocate_time += t_wall;
+    stats.allocate_max   = std::max(stats.allocate_max, t_wall);
+}
+
+// commit every queued target (end of the stream, nothing is reassigned any more)
+void Task_Allocator::finish() {
+    commit(std::numeric_limits<double>::infinity());
+}
+
+// commit the queued targets that have started by a time, hand the rest back to the backlog
+void Task_Allocator::commit(double time) {
+
+    bool returned = false;
+    for (Satellite &sat : satellites) {
+
+        // queues are in start order, so the started ones come first
+        size_t i = 0;
+        for (; i < sat.queue.size() && sat.queue[i].start <= time; i++) {
+            const Assignment &a = sat.queue[i];
+            sat.attitude  = a.attitude;
+            sat.r         = a.r;
+            sat.free_time = a.end;
+
+            double wait = a.end - arrivals[a.target];
+            stats.imaged++;
+            stats.wait_total += wait;
+            stats.wait_max    = std::max(stats.wait_max, wait);
+            stats.busy_total += a.end - a.start;
+            stats.finish_time = std::max(stats.finish_time, a.end);
+        }
+
+        // the rest can still go to whichever satellite gets there first
+        for (; i < sat.queue.size(); i++) {
+            backlog.push_back(sat.queue[i].target);
+            returned = true;
+        }
+        sat.queue.clear();
+    }
+
+    // target indices are in arrival order, so sorting restores the backlog order
+    if (returned) {
+        std::sort(backlog.begin(), backlog.end());
+    }
+}
+
+// drop the backlog targets that have waited longer than the time to live
+void Task_Allocator::expire(double time) {
+
+    // the backlog is in arrival order, so the stale targets are all at the front
+    size_t stale = 0;
+    while (stale < backlog.size() && arrivals[backlog[stale]] + time_to_live < time) {
+        stale++;
+    }
+    backlog.erase(backlog.begin(), backlog.begin() + static_cast<std::ptrdiff_t>(stale));
+    stats.expired += stale;
+}
+
+// plan every candidate for the satellites in rows (across the pool), then find the cheapest untaken one of each
+void Task_Allocator::score_rows() {
+
+    size_t count = candidates.size();
+    if (rows.empty() || remaining == 0) {
+        for (size_t s : rows) {
+            satellites[s].best = count;
+        }
+        return;
+    }
+
+    // one pool job per chunk of a row (a single greedy row still spreads across every thread)
+    size_t chunks = (count + chunk_size - 1) / chunk_size;
+    pool.run(rows.size() * chunks, [this, chunks](size_t job, unsigned) {
+
+        size_t count = candidates.size();
+        size_t s     = rows[job / chunks];
+        size_t begin = (job % chunks) * chunk_size;
+        size_t end   = std::min(begin + chunk_size, count);
+
+        // every pair of the chunk starts from where the satellite will be once its queue is done
+        const Satellite &sat = satellites[s];
+        const Attitude &attitude = sat.tail_attitude();
+        double r = sat.tail_r();
+        double *row = &costs[s * count];
+        Reorientation_Plan plan;
+        for (size_t c = begin; c < end; c++) {
+            if (taken[c]) {
+                continue;
+            }
+            const Target_Point &p = targets[candidates[c]];
+            bool planned = plan_reorientation(attitude, r, p.x, p.y, p.z, sat.roll_wheel, sat.pitch_wheel, sat.yaw_wheel, sat.zoom_rate, plan, planner_mode);
+            row[c] = planned ? plan.total_time : std::numeric_limits<double>::infinity(); // (a target the planner can't point at is never the cheapest)
+        }
+    });
+    stats.plans += static_cast<uint64_t>(rows.size()) * remaining;
+
+    for (size_t s : rows) {
+        find_best(s);
+    }
+}
+
+// cheapest untaken candidate of a satellite's row (no planning)
+void Task_Allocator::find_best(size_t satellite) {
+
+    Satellite &sat = satellites[satellite];
+    size_t count = candidates.size();
+    const double *row = &costs[satellite * count];
+    double start = sat.tail_time(now);
+
+    // ties go to the oldest candidate
+    sat.best      = count;
+    sat.best_time = std::numeric_limits<double>::infinity();
+    for (size_t c = 0; c < count; c++) {
+        if (!taken[c] && start + row[c] < sat.best_time) {
+            sat.best      = c;
+            sat.best_time = start + row[c];
+        }
+    }
+}
+
+// true if a satellite's queue ends before the horizon
+bool Task_Allocator::has_room(size_t satellite) {
+    return satellites[satellite].tail_time(now) < now + horizon;
+}
+
+// queue a candidate on a satellite
+void Task_Allocator::assign(size_t satellite, size_t candidate) {
+
+    Satellite &sat = satellites[satellite];
+    size_t target = candidates[candidate];
+
+    // plan the winning pair once more for the attitude the satellite ends up in
+    Reorientation_Plan plan;
+    const Target_Point &p = targets[target];
+    plan_reorientation(sat.tail_attitude(), sat.tail_r(), p.x, p.y, p.z, sat.roll_wheel, sat.pitch_wheel, sat.yaw_wheel, sat.zoom_rate, plan, planner_mode);
+
+    Assignment a;
+    a.target   = target;
+    a.start    = sat.tail_time(now);
+    a.end      = a.start + plan.total_time;
+    a.attitude = plan.final_attitude;
+    a.r        = plan.target_r;
+    sat.queue.push_back(a);
+
+    taken[candidate] = 1;
+    remaining--;
+
+    // a target handed back by commit() that lands on another satellite counts as reassigned
+    if (owner[target] >= 0 && static_cast<size_t>(owner[target]) != satellite) {
+        stats.reassigned++;
+    }
+    owner[target] = static_cast<int32_t>(satellite);
+}
+
+// assign candidates one at a time, earliest completion first
+void Task_Allocator::greedy() {
+
+    size_t count = candidates.size();
+    while (remaining > 0) {
+
+        // satellite-target pair that finishes earliest
+        size_t winner = satellites.size();
+        for (size_t s = 0; s < satellites.size(); s++) {
+            const Satellite &sat = satellites[s];
+            if (sat.best < count && (winner == satellites.size() || sat.best_time < satellites[winner].best_time)) {
+                winner = s;
+            }
+        }
+        if (winner == satellites.size()) {
+            break;
+        }
+
+        size_t candidate = satellites[winner].best;
+        assign(winner, candidate);
+        stats.rounds++;
+
+        // the winner starts from a new attitude (its whole row is planned again), the others only lose one candidate
+        rows.clear();
+        if (has_room(winner)) {
+            rows.push_back(winner);
+        } else {
+            satellites[winner].best = count;
+        }
+        score_rows();
+        for (size_t s = 0; s < satellites.size(); s++) {
+            if (s != winner && satellites[s].best == candidate) {
+                find_best(s);
+            }
+        }
+    }
+}
+
+// assign candidates in rounds of bids from every satellite with room
+void Task_Allocator::auction() {
+
+    size_t count = candidates.size();
+    size_t none  = satellites.size();
+    while (remaining > 0) {
+
+        // every satellite bids its earliest finishing candidate, the earliest bid per candidate wins
+        bool any = false;
+        for (size_t s = 0; s < satellites.size(); s++) {
+            const Satellite &sat = satellites[s];
+            if (sat.best >= count) {
+                continue;
+            }
+            size_t &bid = bids[sat.best];
+            if (bid == none || sat.best_time < satellites[bid].best_time) {
+                bid = s;
+            }
+            any = true;
+        }
+        if (!any) {
+            break;
+        }
+
+        // award the winning bids (and clear every bid for the next round)
+        rows.clear();
+        for (size_t s = 0; s < satellites.size(); s++) {
+            size_t candidate = satellites[s].best;
+            if (candidate >= count || bids[candidate] != s) {
+                continue;
+            }
+            assign(s, candidate);
+            bids[candidate] = none;
+            if (has_room(s)) {
+                rows.push_back(s);
+            } else {
+                satellites[s].best = count;
+            }
+        }
+        for (size_t s = 0; s < satellites.size(); s++) {
+            if (satellites[s].best < count) {
+                bids[satellites[s].best] = none;
+            }
+        }
+        stats.rounds++;
+
+        // winners start from a new attitude (their rows are planned again), outbid satellites move on to their next best candidate
+        score_rows();
+        for (size_t s = 0; s < satellites.size(); s++) {
+            if (satellites[s].best < count && taken[satellites[s].best]) {
+                find_best(s);
+            }
+        }
+    }
+}
+
+// number of targets waiting for a satellite
+size_t Task_Allocator::get_backlog() {
+    return backlog.size();
+}
+
+// number of targets assigned but not started
+size_t Task_Allocator::get_queued() {
+    size_t queued = 0;
+    for (const Satellite &sat : satellites) {
+        queued += sat.queue.size();
+    }
+    return queued;
+}
+
+// number of satellites in the fleet
+size_t Task_Allocator::get_satellite_count() {
+    return satellites.size();
+}
+
+// number of threads the scoring rows are planned on
+unsigned Task_Allocator::get_thread_count() {
+    return pool.get_thread_count();
+}
+
+// short name of an allocation mode ("greedy" or "auction")
+const char *allocation_mode_name(Allocation_Mode mode) {
+
+    switch (mode) {
+        case Allocation_Mode::Greedy : return "greedy";
+        case Allocation_Mode::Auction: return "auction";
+    }
+    return "";
+}
@@ -0,0 +1,141 @@
+#ifndef TASK_ALLOCATOR_HPP
+#define TASK_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Attitude.hpp"
+#include "Reaction_Wheel.hpp"
+#include "Maneuver_Planner.hpp"
+#include "Satellite_Config.hpp"
+#include "Work_Stealing_Pool.hpp"
+
+/* Assigns a shared stream of imaging targets to a fleet of satellites
+    - Every satellite keeps a queue of assigned targets that covers the next horizon seconds, each allocate() call commits the queued targets
+      that have started by then and hands the rest back, so a target is reassigned to another satellite whenever that became cheaper
+    - A satellite-target pair is scored by its completion time: when the satellite is done with its queue plus the closed form reorientation time
+      (slew and zoom) from the attitude it will be in, under its own reaction wheel limits (see plan_reorientation)
+    - Scoring rows (one satellite against every candidate target) are planned on a work stealing pool, only the rows of satellites whose queue
+      changed are planned again in the next round
+    - Targets wait in arrival order, the oldest window of them are the candidates of each call, and a target that hasn't been assigned and started
+      within the time to live is dropped
+*/
+
+// how satellites and targets are matched
+enum class Allocation_Mode {
+    Greedy, // one assignment per round, the satellite-target pair that finishes earliest (one row planned again per round)
+    Auction // every satellite with room bids its earliest finishing target each round, the lowest bid per target wins (one row per winner planned again)
+};
+
+// running totals of an allocator
+struct Allocation_Stats {
+    size_t   submitted;       // targets submitted
+    size_t   imaged;          // targets whose reorientation started (committed, never reassigned again)
+    size_t   expired;         // targets dropped after waiting longer than the time to live
+    size_t   reassigned;      // times a queued target moved to a different satellite
+    double   wait_total;      // s (arrival to on target, added up over the imaged targets)
+    double   wait_max;        // s (longest arrival to on target)
+    double   busy_total;      // s (reorientation time of the imaged targets, added up over the fleet)
+    double   finish_time;     // s (when the last imaged target is on target)
+    uint64_t plans;           // satellite-target pairs scored
+    uint64_t rounds;          // assignment rounds
+    uint64_t calls;           // allocate() calls
+    double   allocate_time;   // s (wall clock time spent in allocate())
+    double   allocate_max;    // s (longest allocate() call)
+};
+
+class Task_Allocator {
+
+private:
+
+    // target assigned to a satellite but not started yet
+    struct Assignment {
+        size_t   target;   // index of the target
+        double   start;    // s (when the reorientation to it starts)
+        double   end;      // s (when the satellite is on target)
+        Attitude attitude; // attitude on target
+        double   r;        // zoom distance on target
+    };
+
+    // one satellite of the fleet
+    struct Satellite {
+        Reaction_Wheel roll_wheel;  // roll  reaction wheel
+        Reaction_Wheel pitch_wheel; // pitch reaction wheel
+        Reaction_Wheel yaw_wheel;   // yaw   reaction wheel
+        double zoom_rate;           // coordinate units/s
+        Attitude attitude;          // attitude after the last committed target
+        double   r;                 // zoom distance after the last committed target
+        double   free_time;         // s (when the last committed target is done)
+        std::vector<Assignment> queue; // targets assigned but not started yet, in order
+        size_t best;                // position in the candidates of the cheapest untaken target (candidates.size() if none)
+        double best_time;           // s (completion time of that target)
+
+        Satellite(const Satellite_Config &config); // constructor (identity attitude, zoom distance 1, idle)
+
+        const Attitude &tail_attitude() const; // attitude after the last queued target
+        double tail_r() const;                 // zoom distance after the last queued target
+        double tail_time(double now) const;    // s (when the satellite can start another target)
+    };
+
+    Work_Stealing_Pool pool;        // threads the scoring rows are planned on
+    Allocation_Mode mode;           // how satellites and targets are matched
+    Planner_Mode planner_mode;      // how every satellite slews
+    double horizon;                 // s (queues are filled until they reach this far past the current time)
+    double time_to_live;            // s (longest a target waits to be started before it is dropped)
+    size_t window;                  // max candidate targets per allocate() call
+    size_t chunk_size;              // candidates planned per pool job
+
+    std::vector<Satellite> satellites;    // the fleet
+    std::vector<Target_Point> targets;    // every target submitted (global cartesian coords)
+    std::vector<double> arrivals;         // s (arrival time of every target submitted)
+    std::vector<int32_t> owner;           // satellite a target was last queued on (-1 if never)
+    std::vector<size_t> backlog;          // targets waiting for a satellite, in arrival order
+    std::vector<size_t> candidates;       // targets considered by the current call (oldest of the backlog)
+    std::vector<uint8_t> taken;           // 1 if a candidate was assigned during the current call
+    std::vector<double> costs;            // s (reorientation time of every satellite-candidate pair, satellites.size() rows)
+    std::vector<size_t> rows;             // satellites whose rows are planned by the next score_rows()
+    std::vector<size_t> bids;             // winning satellite per candidate during an auction round (satellites.size() if none)
+    size_t remaining;                     // candidates not taken yet
+    double now;                           // s (time of the current call)
+
+    void commit(double time); // commit the queued targets that have started by a time, hand the rest back to the backlog
+
+    void expire(double time); // drop the backlog targets that have waited longer than the time to live
+
+    void score_rows(); // plan every candidate for the satellites in rows (across the pool), then find the cheapest untaken one of each
+
+    void find_best(size_t satellite); // cheapest untaken candidate of a satellite's row (no planning)
+
+    bool has_room(size_t satellite); // true if a satellite's queue ends before the horizon
+
+    void assign(size_t satellite, size_t candidate); // queue a candidate on a satellite
+
+    void greedy(); // assign candidates one at a time, earliest completion first
+
+    void auction(); // assign candidates in rounds of bids from every satellite with room
+
+public:
+
+    Allocation_Stats stats; // running totals
+
+    Task_Allocator(size_t satellite_count, const Satellite_Config &config, Allocation_Mode mode, Planner_Mode planner_mode, unsigned thread_count,
+                   double horizon = 90.0, double time_to_live = 3600.0, size_t window = 2048); // constructor (identical satellites, zero threads means one per core)
+
+    bool submit(double x, double y, double z, double arrival); // add a target to the stream (global cartesian coords, arrival times never decrease), returns false if the point is not valid
+
+    void allocate(double now); // commit what has started by now, then (re)assign the waiting targets to the fleet up to the horizon
+
+    void finish(); // commit every queued target (end of the stream, nothing is reassigned any more)
+
+    size_t get_backlog(); // number of targets waiting for a satellite
+
+    size_t get_queued(); // number of targets assigned but not started
+
+    size_t get_satellite_count(); // number of satellites in the fleet
+
+    unsigned get_thread_count(); // number of threads the scoring rows are planned on
+
+};
+
+const char *allocation_mode_name(Allocation_Mode mode); // short name of an allocation mode ("greedy" or "auction")
+
+#endif
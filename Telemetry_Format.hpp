@@ -0,0 +1,54 @@
+#ifndef TELEMETRY_FORMAT_HPP
+#define TELEMETRY_FORMAT_HPP
+
+#include <cstdint>
+
+/* Telemetry file format (little endian, everything fixed size):
+    - 64 byte Telemetry_Header at offset 0
+    - followed by a ring of capacity Telemetry_Record slots, record n (counting from the start of the recording) is in slot n % capacity
+    - the file always holds the last min(written, capacity) records, the oldest is record written - min(written, capacity)
+    - the recorder writes the record first and bumps written after it, so a reader never sees a count that includes a half written record
+      (a reader of a live file can still have its oldest records overwritten while reading them)
+    - state is stored as float (plenty for display and analysis), time and frame counter as 64 bit values
+*/
+
+// telemetry file header
+struct Telemetry_Header {
+    char     magic[8];     // "SATTELEM"
+    uint32_t version;      // format version (telemetry_version)
+    uint32_t record_size;  // bytes per record (sizeof(Telemetry_Record))
+    uint64_t capacity;     // number of record slots in the ring
+    uint64_t written;      // total records written since the recording started
+    double   frame_period; // s (physics frame period of the recording)
+    uint8_t  reserved[24]; // zero
+};
+
+// one physics frame of telemetry (the state shown by the console dashboard)
+struct Telemetry_Record {
+    uint64_t frame;             // physics frame counter
+    double   sim_time;          // s (simulation time since the session started)
+    float    targ_global[3];    // target point global cartesian coords
+    float    curr_global[3];    // current focus point global cartesian coords
+    float    targ_local[3];     // target point local cartesian coords
+    float    curr_local[3];     // current focus point local cartesian coords
+    float    targ_spherical[3]; // target point local spherical coords (r, theta, phi) [-, rad, rad]
+    float    curr_spherical[3]; // current focus point local spherical coords (r, theta, phi) [-, rad, rad]
+    float    attitude[4];       // attitude quaternion (w, x, y, z), global to local cartesian coords
+    float    omega[3];          // rad/s (roll, pitch, yaw)
+    float    saturation[3];     // % (roll, pitch, yaw reaction wheel saturation)
+    float    zoom_dist;         // optical zoom distance
+    float    frame_time;        // s (wall clock time of the previous frame, zero with the step clock)
+    float    sleep_overshoot;   // s (how late the previous frame's sleep woke up past its deadline)
+    uint16_t status;            // status message code (Status_Message, 0 for none)
+    uint16_t flags;             // telemetry_flag_* bits
+};
+
+static const uint16_t telemetry_flag_missed_deadline = 1; // the previous frame ended past its deadline
+
+static const char     telemetry_magic[8] = {'S', 'A', 'T', 'T', 'E', 'L', 'E', 'M'}; // file signature
+static const uint32_t telemetry_version  = 2;                                        // current format version
+
+static_assert(sizeof(Telemetry_Header) == 64 , "telemetry header layout changed");
+static_assert(sizeof(Telemetry_Record) == 144, "telemetry record layout changed");
+
+#endif
@@ -0,0 +1,119 @@
+#include "Telemetry_Reader.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// constructor (maps and validates the telemetry file)
+Telemetry_Reader::Telemetry_Reader(const char *path):
+
+    // map the whole file read-only
+    file(path)
+
+{
+    header  = nullptr;
+    records = nullptr;
+    count   = 0;
+    first   = 0;
+
+    // check the header before trusting anything in the file
+    if (!file.is_open() || file.size() < sizeof(Telemetry_Header)) {
+        return;
+    }
+    const Telemetry_Header *h = reinterpret_cast<const Telemetry_Header *>(file.data());
+    if (std::memcmp(h->magic, telemetry_magic, sizeof(telemetry_magic)) != 0 || h->version != telemetry_version ||
+        h->record_size != sizeof(Telemetry_Record) || h->capacity == 0 ||
+        h->capacity > (file.size() - sizeof(Telemetry_Header)) / sizeof(Telemetry_Record)) {
+        return;
+    }
+
+    // the ring holds the most recent records
+    header  = h;
+    records = reinterpret_cast<const Telemetry_Record *>(file.data() + sizeof(Telemetry_Header));
+    count   = std::min(header->written, header->capacity);
+    first   = header->written - count;
+}
+
+// true if the file is a valid telemetry file
+bool Telemetry_Reader::is_open() {
+    return header != nullptr;
+}
+
+// number of records available
+uint64_t Telemetry_Reader::size() {
+    return count;
+}
+
+// number of older records that were overwritten by the ring
+uint64_t Telemetry_Reader::get_dropped() {
+    return first;
+}
+
+// s (physics frame period of the recording)
+double Telemetry_Reader::get_frame_period() {
+    return (header != nullptr) ? header->frame_period : 0.0;
+}
+
+// record by index, oldest first (index must be less than size())
+const Telemetry_Record &Telemetry_Reader::record(uint64_t index) {
+    return records[(first + index) % header->capacity];
+}
+
+// index of the last record at or before a simulation time (0 if the time is before the first record)
+uint64_t Telemetry_Reader::find_time(double sim_time) {
+
+    // binary search for the first record after the time (touches only log2(n) records of the mapping)
+    uint64_t low  = 0;
+    uint64_t high = count;
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+        if (record(middle).sim_time <= sim_time) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // the record before it is the one on screen at that time
+    return (low > 0) ? low - 1 : 0;
+}
+
+// convert a record back into a dashboard snapshot
+void Telemetry_Reader::to_snapshot(const Telemetry_Record &record, Satellite_Snapshot &snapshot) {
+
+    snapshot.frame    = record.frame;
+    snapshot.sim_time = record.sim_time;
+    for (int i = 0; i < 3; i++) {
+        snapshot.targ_global[i]    = record.targ_global[i];
+        snapshot.curr_global[i]    = record.curr_global[i];
+        snapshot.targ_local[i]     = record.targ_local[i];
+        snapshot.curr_local[i]     = record.curr_local[i];
+        snapshot.targ_spherical[i] = record.targ_spherical[i];
+        snapshot.curr_spherical[i] = record.curr_spherical[i];
+    }
+    snapshot.attitude         = Attitude(record.attitude[0], record.attitude[1], record.attitude[2], record.attitude[3]);
+    snapshot.omega_roll       = record.omega[0];
+    snapshot.omega_pitch      = record.omega[1];
+    snapshot.omega_yaw        = record.omega[2];
+    snapshot.saturation_roll  = record.saturation[0];
+    snapshot.saturation_pitch = record.saturation[1];
+    snapshot.saturation_yaw   = record.saturation[2];
+    snapshot.zoom_dist        = record.zoom_dist;
+    snapshot.frame_time       = record.frame_time;
+    snapshot.sleep_overshoot  = record.sleep_overshoot;
+    snapshot.missed_deadline  = (record.flags & telemetry_flag_missed_deadline) != 0;
+    snapshot.status           = static_cast<Status_Message>(record.status);
+    std::snprintf(snapshot.message, sizeof(snapshot.message), "%s", status_text(snapshot.status));
+
+    // the catalog lookup isn't recorded (the planet octant is shown instead)
+    snapshot.catalog_name[0]  = '\0';
+    snapshot.catalog_angle    = 0.0;
+
+    // maneuver pacing statistics aren't recorded (they can be rebuilt from the per-frame times)
+    snapshot.frame_p50        = 0.0;
+    snapshot.frame_p99        = 0.0;
+    snapshot.jitter_p99       = 0.0;
+    snapshot.overshoot_max    = 0.0;
+    snapshot.frames_timed     = 0;
+    snapshot.frames_missed    = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef TELEMETRY_READER_HPP
+#define TELEMETRY_READER_HPP
+
+#include "Mapped_File.hpp"
+#include "Satellite_Snapshot.hpp"
+#include "Telemetry_Format.hpp"
+
+/* Reads a telemetry file written by Telemetry_Recorder (see Telemetry_Format.hpp)
+    - Records are numbered oldest first, record 0 is the oldest one still in the ring
+    - Every record is read straight from the mapping, nothing is decoded up front
+    - Records are in time order, so the ring itself is the time index: find_time() binary searches it in O(log n)
+*/
+
+class Telemetry_Reader {
+
+private:
+
+    Mapped_File file;                // memory mapped telemetry file
+    const Telemetry_Header *header;  // header at the start of the mapping (nullptr if the file is not a valid telemetry file)
+    const Telemetry_Record *records; // ring of record slots after the header
+    uint64_t count;                  // number of records in the ring
+    uint64_t first;                  // recording index of the oldest record in the ring
+
+public:
+
+    Telemetry_Reader(const char *path); // constructor (maps and validates the telemetry file)
+
+    bool is_open(); // true if the file is a valid telemetry file
+
+    uint64_t size(); // number of records available
+
+    uint64_t get_dropped(); // number of older records that were overwritten by the ring
+
+    double get_frame_period(); // s (physics frame period of the recording)
+
+    const Telemetry_Record &record(uint64_t index); // record by index, oldest first (index must be less than size())
+
+    uint64_t find_time(double sim_time); // index of the last record at or before a simulation time (0 if the time is before the first record)
+
+    static void to_snapshot(const Telemetry_Record &record, Satellite_Snapshot &snapshot); // convert a record back into a dashboard snapshot
+
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "Telemetry_Recorder.hpp"
+
+#include <atomic>
+#include <cstring>
+
+// constructor (creates the file, capacity is the number of frames kept)
+Telemetry_Recorder::Telemetry_Recorder(const char *path, uint64_t capacity):
+
+    // create and map the whole file up front
+    file(path, sizeof(Telemetry_Header) + static_cast<size_t>(capacity) * sizeof(Telemetry_Record))
+
+{
+    this->capacity = capacity;
+    written        = 0;
+    header         = nullptr;
+    records        = nullptr;
+
+    if (!file.is_open() || capacity == 0) {
+        return;
+    }
+
+    // fill in the header
+    header  = reinterpret_cast<Telemetry_Header *>(file.writable_data());
+    records = reinterpret_cast<Telemetry_Record *>(file.writable_data() + sizeof(Telemetry_Header));
+    std::memset(header, 0, sizeof(Telemetry_Header));
+    std::memcpy(header->magic, telemetry_magic, sizeof(telemetry_magic));
+    header->version      = telemetry_version;
+    header->record_size  = sizeof(Telemetry_Record);
+    header->capacity     = capacity;
+    header->written      = 0;
+    header->frame_period = 0.0;
+}
+
+// s (physics frame period stored in the header)
+void Telemetry_Recorder::set_frame_period(double frame_period) {
+    if (header != nullptr) {
+        header->frame_period = frame_period;
+    }
+}
+
+// true if the telemetry file was created and mapped successfully
+bool Telemetry_Recorder::is_open() {
+    return header != nullptr;
+}
+
+// write one frame of telemetry
+void Telemetry_Recorder::record(const Satellite_Snapshot &snapshot) {
+
+    if (header == nullptr) {
+        return;
+    }
+
+    // fill in the next slot of the ring directly in the mapping
+    fill_telemetry_record(snapshot, records[written % capacity]);
+
+    // publish the count only after the record is complete (for readers of a live file)
+    written++;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->written = written;
+}
+
+// convert a snapshot into a telemetry record (state narrowed to float, the status text and catalog lookup are left out)
+void fill_telemetry_record(const Satellite_Snapshot &snapshot, Telemetry_Record &r) {
+
+    r.frame    = snapshot.frame;
+    r.sim_time = snapshot.sim_time;
+    for (int i = 0; i < 3; i++) {
+        r.targ_global[i]    = static_cast<float>(snapshot.targ_global[i]);
+        r.curr_global[i]    = static_cast<float>(snapshot.curr_global[i]);
+        r.targ_local[i]     = static_cast<float>(snapshot.targ_local[i]);
+        r.curr_local[i]     = static_cast<float>(snapshot.curr_local[i]);
+        r.targ_spherical[i] = static_cast<float>(snapshot.targ_spherical[i]);
+        r.curr_spherical[i] = static_cast<float>(snapshot.curr_spherical[i]);
+    }
+    r.attitude[0]   = static_cast<float>(snapshot.attitude.w);
+    r.attitude[1]   = static_cast<float>(snapshot.attitude.x);
+    r.attitude[2]   = static_cast<float>(snapshot.attitude.y);
+    r.attitude[3]   = static_cast<float>(snapshot.attitude.z);
+    r.omega[0]      = static_cast<float>(snapshot.omega_roll);
+    r.omega[1]      = static_cast<float>(snapshot.omega_pitch);
+    r.omega[2]      = static_cast<float>(snapshot.omega_yaw);
+    r.saturation[0] = static_cast<float>(snapshot.saturation_roll);
+    r.saturation[1] = static_cast<float>(snapshot.saturation_pitch);
+    r.saturation[2] = static_cast<float>(snapshot.saturation_yaw);
+    r.zoom_dist     = static_cast<float>(snapshot.zoom_dist);
+    r.frame_time      = static_cast<float>(snapshot.frame_time);
+    r.sleep_overshoot = static_cast<float>(snapshot.sleep_overshoot);
+    r.status        = static_cast<uint16_t>(snapshot.status);
+    r.flags         = snapshot.missed_deadline ? telemetry_flag_missed_deadline : 0;
+}
+
+// total records written
+uint64_t Telemetry_Recorder::get_written() {
+    return written;
+}
+
+// number of records the ring keeps
+uint64_t Telemetry_Recorder::get_capacity() {
+    return capacity;
+}
@@ -0,0 +1,42 @@
+#ifndef TELEMETRY_RECORDER_HPP
+#define TELEMETRY_RECORDER_HPP
+
+#include "Mapped_File.hpp"
+#include "Satellite_Snapshot.hpp"
+#include "Telemetry_Format.hpp"
+
+// convert a snapshot into a telemetry record (state narrowed to float, the status text and catalog lookup are left out)
+void fill_telemetry_record(const Satellite_Snapshot &snapshot, Telemetry_Record &record);
+
+/* Writes one Telemetry_Record per physics frame into a memory mapped ring buffer file (see Telemetry_Format.hpp)
+    - The file is created at its full size up front, recording a frame is a plain copy into the mapping (no allocation, no lock, no system call)
+    - The operating system writes the pages back to disk in the background, and on exit
+*/
+
+class Telemetry_Recorder {
+
+private:
+
+    Mapped_File file;          // memory mapped telemetry file
+    Telemetry_Header *header;  // header at the start of the mapping
+    Telemetry_Record *records; // ring of record slots after the header
+    uint64_t capacity;         // number of record slots
+    uint64_t written;          // total records written
+
+public:
+
+    Telemetry_Recorder(const char *path, uint64_t capacity); // constructor (creates the file, capacity is the number of frames kept)
+
+    void set_frame_period(double frame_period); // s (physics frame period stored in the header)
+
+    bool is_open(); // true if the telemetry file was created and mapped successfully
+
+    void record(const Satellite_Snapshot &snapshot); // write one frame of telemetry
+
+    uint64_t get_written(); // total records written
+
+    uint64_t get_capacity(); // number of records the ring keeps
+
+};
+
+#endif
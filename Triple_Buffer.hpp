@@ -0,0 +1,48 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/* Lock-free single producer, single consumer triple buffer
+    - The writer always owns one slot, the reader always owns one slot, and the third slot holds the latest published value
+    - publish() and fetch() swap slots with a single atomic exchange, so neither side ever waits for the other
+    - The reader only sees the most recent value, anything published in between is dropped (exactly what a renderer wants)
+*/
+
+template <typename T>
+class Triple_Buffer {
+
+private:
+
+    static const unsigned fresh_bit = 4u; // set in middle when it holds a value the reader hasn't taken yet
+
+    T slots[3];                   // the three buffers
+    unsigned back;                // slot owned by the writer
+    unsigned front;               // slot owned by the reader
+    std::atomic<unsigned> middle; // slot holding the latest published value (plus fresh_bit)
+
+public:
+
+    Triple_Buffer(): slots(), back(0), front(1), middle(2) {} // constructor
+
+    T &write_slot() {return slots[back];} // slot to fill in before publish() (writer thread only)
+
+    // make the write slot the latest value (writer thread only)
+    void publish() {
+        back = middle.exchange(back | fresh_bit, std::memory_order_acq_rel) & 3u;
+    }
+
+    // take the latest value if there is a new one, returns false if nothing was published since the last fetch (reader thread only)
+    bool fetch() {
+        if ((middle.load(std::memory_order_relaxed) & fresh_bit) == 0) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & 3u;
+        return true;
+    }
+
+    const T &read_slot() const {return slots[front];} // latest value taken by fetch() (reader thread only)
+
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "Work_Stealing_Pool.hpp"
+
+#include <algorithm>
+
+// constructor (starts thread_count - 1 worker threads, zero means one per core)
+Work_Stealing_Pool::Work_Stealing_Pool(unsigned thread_count) {
+
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    job        = nullptr;
+    run_number = 0;
+    busy       = 0;
+    stopping   = false;
+    steals     = 0;
+
+    // one queue per worker, all empty
+    for (unsigned w = 0; w < thread_count; w++) {
+        queues.emplace_back(new Worker_Queue());
+        queues.back()->begin = 0;
+        queues.back()->end   = 0;
+    }
+
+    // start the workers (the calling thread is worker 0)
+    for (unsigned w = 1; w < thread_count; w++) {
+        threads.emplace_back(&Work_Stealing_Pool::worker_loop, this, w);
+    }
+}
+
+// destructor (stops and joins the workers)
+Work_Stealing_Pool::~Work_Stealing_Pool() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    start_condition.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// number of workers, including the calling thread
+unsigned Work_Stealing_Pool::get_thread_count() {
+    return static_cast<unsigned>(queues.size());
+}
+
+// number of successful steals over all runs
+uint64_t Work_Stealing_Pool::get_steals() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return steals;
+}
+
+// run function(index, worker) for every index in [0, count) and wait for all of them (worker is in [0, thread count))
+void Work_Stealing_Pool::run(size_t count, const std::function<void(size_t index, unsigned worker)> &function) {
+
+    // split the jobs evenly between the workers
+    size_t workers = queues.size();
+    for (size_t w = 0; w < workers; w++) {
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        queues[w]->begin = count * w / workers;
+        queues[w]->end   = count * (w + 1) / workers;
+    }
+
+    // wake the workers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job  = &function;
+        busy = static_cast<unsigned>(threads.size());
+        run_number++;
+    }
+    start_condition.notify_all();
+
+    // work alongside them, then wait for the last one to finish
+    work(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    done_condition.wait(lock, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+// body of worker threads 1 and up (wait for a run, work on it, repeat)
+void Work_Stealing_Pool::worker_loop(unsigned worker) {
+
+    uint64_t last_run = 0;
+    while (true) {
+
+        // wait for the next run
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_condition.wait(lock, [&] { return stopping || run_number != last_run; });
+            if (stopping) {
+                return;
+            }
+            last_run = run_number;
+        }
+
+        work(worker);
+
+        // report this part of the run done
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+            if (busy == 0) {
+                done_condition.notify_one();
+            }
+        }
+    }
+}
+
+// run jobs from the worker's own queue, then steal until every queue is empty
+void Work_Stealing_Pool::work(unsigned worker) {
+
+    Worker_Queue &queue = *queues[worker];
+    do {
+        while (true) {
+
+            // take the next job from the front of the own range
+            size_t index;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.begin >= queue.end) {
+                    break;
+                }
+                index = queue.begin++;
+            }
+
+            (*job)(index, worker);
+        }
+    } while (steal(worker));
+}
+
+// move the back half of the largest other range into the worker's queue, returns false if every queue is empty
+bool Work_Stealing_Pool::steal(unsigned worker) {
+
+    size_t workers = queues.size();
+    while (true) {
+
+        // find the victim with the most jobs left (sizes are only a hint, they are checked again under the victim's lock)
+        size_t victim  = workers;
+        size_t largest = 0;
+        for (size_t k = 1; k < workers; k++) {
+            size_t w = (worker + k) % workers;
+            std::lock_guard<std::mutex> lock(queues[w]->mutex);
+            size_t left = queues[w]->end - std::min(queues[w]->begin, queues[w]->end);
+            if (left > largest) {
+                largest = left;
+                victim  = w;
+            }
+        }
+        if (victim == workers) {
+            return false;
+        }
+
+        // take the back half (at least one job, a single job left is taken whole)
+        size_t begin, end;
+        {
+            std::lock_guard<std::mutex> lock(queues[victim]->mutex);
+            Worker_Queue &v = *queues[victim];
+            if (v.begin >= v.end) {
+                continue; // (emptied in the meantime, look again)
+            }
+            size_t left = v.end - v.begin;
+            begin = v.end - (left + 1) / 2;
+            end   = v.end;
+            v.end = begin;
+        }
+
+        // the stolen range becomes the worker's own (so it can be stolen from in turn)
+        {
+            std::lock_guard<std::mutex> lock(queues[worker]->mutex);
+            queues[worker]->begin = begin;
+            queues[worker]->end   = end;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            steals++;
+        }
+        return true;
+    }
+}
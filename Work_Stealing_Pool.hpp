@@ -0,0 +1,63 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Thread pool that spreads a range of independent jobs across worker threads by work stealing
+    - Each worker owns a queue holding one contiguous range of job indices, a run starts by splitting [0, count) evenly between them
+    - A worker takes jobs from the front of its own range, one at a time, and once it runs dry it steals the back half of the
+      largest range left (so uneven jobs, e.g. slow and fast satellite configs, still keep every core busy to the end)
+    - Workers are started once and sleep between runs, the thread that calls run() works as worker 0
+*/
+
+class Work_Stealing_Pool {
+
+private:
+
+    // range of job indices owned by one worker (padded to a cache line so workers don't slow each other down)
+    struct alignas(64) Worker_Queue {
+        std::mutex mutex;
+        size_t begin; // first job not taken yet
+        size_t end;   // one past the last job of the range
+    };
+
+    std::vector<std::unique_ptr<Worker_Queue>> queues; // one queue per worker (worker 0 is the calling thread)
+    std::vector<std::thread> threads;                   // workers 1 and up
+
+    std::mutex mutex;                        // guards everything below
+    std::condition_variable start_condition; // signals the workers that a run started (or the pool is stopping)
+    std::condition_variable done_condition;  // signals the calling thread that a worker finished its part of a run
+    const std::function<void(size_t, unsigned)> *job; // job of the current run
+    uint64_t run_number;                     // number of runs started (workers wait for it to change)
+    unsigned busy;                           // number of workers (other than the calling thread) still working on the current run
+    bool stopping;                           // true once the destructor asks the workers to exit
+    uint64_t steals;                         // number of successful steals over all runs
+
+    void worker_loop(unsigned worker); // body of worker threads 1 and up (wait for a run, work on it, repeat)
+
+    void work(unsigned worker); // run jobs from the worker's own queue, then steal until every queue is empty
+
+    bool steal(unsigned worker); // move the back half of the largest other range into the worker's queue, returns false if every queue is empty
+
+public:
+
+    Work_Stealing_Pool(unsigned thread_count); // constructor (starts thread_count - 1 worker threads, zero means one per core)
+
+    ~Work_Stealing_Pool(); // destructor (stops and joins the workers)
+
+    unsigned get_thread_count(); // number of workers, including the calling thread
+
+    uint64_t get_steals(); // number of successful steals over all runs
+
+    void run(size_t count, const std::function<void(size_t index, unsigned worker)> &function); // run function(index, worker) for every index in [0, count) and wait for all of them (worker is in [0, thread count))
+
+};
+
+#endif
@@ -1,27 +1,412 @@
 
+#include <cstring>
+#include <cstdlib>
+#include <memory>
 #include "Ideal_Cube_Sat.hpp"
+#include "Batch_Runner.hpp"
+#include "Benchmark_Suite.hpp"
 
-int main() {
+/* Command line options:
+    --headless         never write the dashboard, read "X Y Z" targets from stdin until end of input and print one result line per target
+    --clock <mode>     simulation clock mode: "wall" (default, realtime), "warp" (scaled wall clock), or "step" (free-running fixed steps)
+    --warp <factor>    time warp factor for the "warp" clock (e.g. 10 or 1000), implies "--clock warp"
+    --batch <targets> <results>
+                       headless batch run, reorient to every target in the target file and write one CSV metrics row per target
+                       (uses the "step" clock unless a clock is given explicitly)
+    --planner <mode>   slew planner: "two-step" (default, roll then pitch or yaw), "eigen" (single eigen-axis rotation),
+                       or "concurrent" (roll, pitch or yaw, and zoom all at once), time saved per maneuver is reported
+    --sequence <targets>
+                       order the targets in the target file to minimize total slew time, report the savings versus file order, then execute the plan
+    --constellation <count> <seconds>
+                       step a constellation of satellites through random eigen-axis retargets, report the cost per satellite-step of the AVX2 and reference kernels
+    --record <file>    write every physics frame to a binary telemetry file (memory mapped ring buffer, keeps the most recent frames)
+    --record-frames <count>
+                       number of frames the telemetry ring keeps (default 216000, one hour at 60 FPS)
+    --telemetry-csv <file> <csv>
+                       convert a telemetry file to CSV, one row per recorded frame
+    --replay <file>    replay a telemetry file on the dashboard ("play", "pause", "seek <s>", "warp <x>", "quit" on stdin, --warp sets the initial warp)
+    --benchmark <results>
+                       run the math kernel and reorientation microbenchmarks, write ns/op and allocations/op to a CSV results file
+    --benchmark-baseline <baseline>
+                       compare the benchmark results with an earlier results file, exit code 1 on a regression
+    --catalog <file>   show the catalog target nearest to where the satellite is looking on the dashboard ("X Y Z name" lines, replaces the planet octant)
+    --fov-passes <targets> <passes>
+                       plan a slew to every target in the target file in order and write every --catalog target that passes through the field of view to a CSV file
+    --fov <degrees>    field of view half angle for --fov-passes (default 1)
+    --config <file>    satellite and reaction wheel properties ("name value" lines, see Satellite_Config.hpp), used by every simulation mode
+    --sweep <sweep> <targets> <results>
+                       run a headless reorientation campaign over the target file for every satellite config of the sweep file (grid values or random samples),
+                       spread across all cores, and write slew time and saturation statistics per config to a CSV file
+    --fleet <count> <targets>
+                       fly a fleet of headless satellites through a reorientation campaign over the target file (each starting at a different target),
+                       interleaved one frame at a time on a few threads by coroutines, report satellite-frames per second
+    --allocate <satellites> <per hour> <hours>
+                       stream random imaging targets to a fleet of satellites and assign them once a minute by slew cost (closed form plan from each satellite's
+                       queued attitude), report imaged and expired targets, waiting times, and allocation time
+    --allocator <mode> how --allocate matches satellites and targets: "auction" (default, every satellite bids each round) or "greedy" (earliest completion first)
+    --threads <count>  worker threads for --sweep, --fleet, and --allocate (default one per core)
+    --server <socket>  serve plan, execute, and state stream requests from local tools on a Unix domain socket (binary protocol, see Server_Protocol.hpp, Linux only)
+                       with one headless satellite until Ctrl+C (uses the "step" clock unless a clock is given explicitly)
+    --alloc-test       run reorientations with every planner mode on the dashboard and check the maneuver and render loops never allocate
+*/
+
+int main(int argc, char *argv[]) {
+
+    // default options reproduce the original interactive realtime simulator
+    Clock_Mode clock_mode = Clock_Mode::Wall;
+    double     time_scale = 1.0;
+    bool       headless   = false;
+    bool       clock_set  = false;   // true if the clock mode was given explicitly
+    const char *batch_targets = nullptr; // target file for batch mode
+    const char *batch_results = nullptr; // results file for batch mode
+    const char *sequence_targets = nullptr; // target file for sequence mode
+    size_t constellation_count    = 0;       // number of satellites for constellation mode (0 when not requested)
+    double constellation_duration = 0.0;     // s (simulated time for constellation mode)
+    const char *record_path   = nullptr;     // telemetry file to record to
+    long long   record_frames = 216000;      // number of frames the telemetry ring keeps
+    const char *export_telemetry = nullptr;  // telemetry file to convert to CSV
+    const char *export_csv       = nullptr;  // CSV file the telemetry is converted to
+    const char *replay_path      = nullptr;  // telemetry file to replay on the dashboard
+    const char *benchmark_results  = nullptr; // results file for the benchmarks
+    const char *benchmark_baseline = nullptr; // earlier results file the benchmarks are compared with
+    bool allocation_test = false;             // if true, run the allocation test
+    const char *catalog_path = nullptr;       // target catalog file for the dashboard and the field of view passes
+    const char *fov_targets  = nullptr;       // target file for the field of view passes
+    const char *fov_passes   = nullptr;       // results file for the field of view passes
+    double fov_half_angle    = 1.0;           // deg (field of view half angle)
+    Satellite_Config config;                  // satellite and reaction wheel properties
+    const char *sweep_path    = nullptr;      // sweep file for sweep mode
+    const char *sweep_targets = nullptr;      // target file for sweep mode
+    const char *sweep_results = nullptr;      // results file for sweep mode
+    unsigned    thread_count  = 0;            // worker threads for sweep, fleet, and allocation mode (0 for one per core)
+    size_t      fleet_count   = 0;            // number of satellites for fleet mode (0 when not requested)
+    const char *fleet_targets = nullptr;      // target file for fleet mode
+    size_t allocate_satellites = 0;           // number of satellites for allocation mode (0 when not requested)
+    double allocate_rate       = 0.0;         // targets per hour for allocation mode
+    double allocate_hours      = 0.0;         // h (length of the target stream for allocation mode)
+    Allocation_Mode allocation_mode = Allocation_Mode::Auction; // how allocation mode matches satellites and targets
+    const char *server_socket = nullptr;      // socket path for server mode
+    Planner_Mode planner_mode = Planner_Mode::Roll_Then_Tilt; // how the satellite slews to new targets
+
+    // parse command line options
+    for (int i = 1; i < argc; i++) {
+
+        if (std::strcmp(argv[i], "--headless") == 0) {
+
+            headless = true;
+
+        } else if (std::strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+
+            i++;
+            clock_set = true;
+            if      (std::strcmp(argv[i], "wall") == 0) {clock_mode = Clock_Mode::Wall;   }
+            else if (std::strcmp(argv[i], "warp") == 0) {clock_mode = Clock_Mode::Scaled; }
+            else if (std::strcmp(argv[i], "step") == 0) {clock_mode = Clock_Mode::Stepped;}
+            else {
+                std::cerr << "ERROR: Unknown clock mode '" << argv[i] << "' (expected wall, warp, or step)" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--warp") == 0 && i + 1 < argc) {
+
+            i++;
+            time_scale = std::atof(argv[i]);
+            clock_mode = Clock_Mode::Scaled;
+            clock_set  = true;
+            if (time_scale <= 0.0) {
+                std::cerr << "ERROR: Time warp factor must be a positive number" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 2 < argc) {
+
+            batch_targets = argv[++i];
+            batch_results = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--planner") == 0 && i + 1 < argc) {
+
+            i++;
+            if      (std::strcmp(argv[i], "two-step"  ) == 0) {planner_mode = Planner_Mode::Roll_Then_Tilt;}
+            else if (std::strcmp(argv[i], "eigen"     ) == 0) {planner_mode = Planner_Mode::Eigen_Axis;    }
+            else if (std::strcmp(argv[i], "concurrent") == 0) {planner_mode = Planner_Mode::Concurrent;    }
+            else {
+                std::cerr << "ERROR: Unknown planner mode '" << argv[i] << "' (expected two-step, eigen, or concurrent)" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--sequence") == 0 && i + 1 < argc) {
+
+            sequence_targets = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--constellation") == 0 && i + 2 < argc) {
+
+            long count             = std::atol(argv[++i]);
+            constellation_duration = std::atof(argv[++i]);
+            if (count <= 0 || constellation_duration <= 0.0) {
+                std::cerr << "ERROR: Constellation size and duration must be positive numbers" << std::endl;
+                return 1;
+            }
+            constellation_count = static_cast<size_t>(count);
+
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+
+            record_path = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--record-frames") == 0 && i + 1 < argc) {
+
+            record_frames = std::atoll(argv[++i]);
+            if (record_frames <= 0) {
+                std::cerr << "ERROR: Number of recorded frames must be a positive number" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--telemetry-csv") == 0 && i + 2 < argc) {
+
+            export_telemetry = argv[++i];
+            export_csv       = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+
+            replay_path = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc) {
+
+            benchmark_results = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--benchmark-baseline") == 0 && i + 1 < argc) {
+
+            benchmark_baseline = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--catalog") == 0 && i + 1 < argc) {
+
+            catalog_path = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--fov-passes") == 0 && i + 2 < argc) {
+
+            fov_targets = argv[++i];
+            fov_passes  = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--fov") == 0 && i + 1 < argc) {
+
+            fov_half_angle = std::atof(argv[++i]);
+            if (fov_half_angle <= 0.0 || fov_half_angle >= 180.0) {
+                std::cerr << "ERROR: Field of view half angle must be between 0 and 180 degrees" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+
+            if (!config.load(argv[++i])) {
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--sweep") == 0 && i + 3 < argc) {
+
+            sweep_path    = argv[++i];
+            sweep_targets = argv[++i];
+            sweep_results = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--fleet") == 0 && i + 2 < argc) {
+
+            long count    = std::atol(argv[++i]);
+            fleet_targets = argv[++i];
+            if (count <= 0) {
+                std::cerr << "ERROR: Fleet size must be a positive number" << std::endl;
+                return 1;
+            }
+            fleet_count = static_cast<size_t>(count);
+
+        } else if (std::strcmp(argv[i], "--allocate") == 0 && i + 3 < argc) {
+
+            long count     = std::atol(argv[++i]);
+            allocate_rate  = std::atof(argv[++i]);
+            allocate_hours = std::atof(argv[++i]);
+            if (count <= 0 || allocate_rate <= 0.0 || allocate_hours <= 0.0) {
+                std::cerr << "ERROR: Number of satellites, targets per hour, and hours must be positive numbers" << std::endl;
+                return 1;
+            }
+            allocate_satellites = static_cast<size_t>(count);
+
+        } else if (std::strcmp(argv[i], "--allocator") == 0 && i + 1 < argc) {
+
+            i++;
+            if      (std::strcmp(argv[i], "auction") == 0) {allocation_mode = Allocation_Mode::Auction;}
+            else if (std::strcmp(argv[i], "greedy" ) == 0) {allocation_mode = Allocation_Mode::Greedy; }
+            else {
+                std::cerr << "ERROR: Unknown allocator '" << argv[i] << "' (expected auction or greedy)" << std::endl;
+                return 1;
+            }
+
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+
+            long count = std::atol(argv[++i]);
+            if (count <= 0) {
+                std::cerr << "ERROR: Number of threads must be a positive number" << std::endl;
+                return 1;
+            }
+            thread_count = static_cast<unsigned>(count);
+
+        } else if (std::strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+
+            server_socket = argv[++i];
+
+        } else if (std::strcmp(argv[i], "--alloc-test") == 0) {
+
+            allocation_test = true;
+
+        } else {
+
+            std::cerr << "ERROR: Unknown option '" << argv[i] << "'" << std::endl;
+            std::cerr << "Usage: main.exe [--headless] [--clock wall|warp|step] [--warp <factor>] [--planner two-step|eigen|concurrent] [--batch <targets> <results>] [--sequence <targets>] [--constellation <count> <seconds>]"
+                      << " [--record <file>] [--record-frames <count>] [--telemetry-csv <file> <csv>] [--replay <file>]"
+                      << " [--benchmark <results>] [--benchmark-baseline <baseline>] [--catalog <file>] [--fov-passes <targets> <passes>] [--fov <degrees>]"
+                      << " [--config <file>] [--sweep <sweep> <targets> <results>] [--fleet <count> <targets>]"
+                      << " [--allocate <satellites> <per hour> <hours>] [--allocator auction|greedy] [--threads <count>] [--server <socket>] [--alloc-test]" << std::endl;
+            return 1;
+        }
+    }
+
+    // benchmarks run on their own
+    if (benchmark_results != nullptr) {
+        return run_benchmarks(benchmark_results, benchmark_baseline);
+    }
+
+    // telemetry export only reads a file
+    if (export_telemetry != nullptr) {
+        return run_telemetry_export(export_telemetry, export_csv);
+    }
+
+    // replay only reads a file
+    if (replay_path != nullptr) {
+        return run_replay(replay_path, time_scale);
+    }
+
+    // field of view passes are planned in closed form (no frames simulated)
+    if (fov_targets != nullptr) {
+        if (catalog_path == nullptr) {
+            std::cerr << "ERROR: --fov-passes needs a target catalog (--catalog <file>)" << std::endl;
+            return 1;
+        }
+        return run_fov_passes(fov_targets, fov_passes, catalog_path, fov_half_angle * M_PI / 180.0, planner_mode, config);
+    }
+
+    // parameter sweeps run their own headless satellites
+    if (sweep_path != nullptr) {
+        return run_sweep(sweep_path, sweep_targets, sweep_results, planner_mode, config, thread_count);
+    }
+
+    // fleet mode interleaves its own headless satellites
+    if (fleet_count > 0) {
+        return run_fleet(fleet_count, fleet_targets, planner_mode, config, thread_count);
+    }
+
+    // allocation mode plans in closed form (no frames simulated)
+    if (allocate_satellites > 0) {
+        return run_allocation(allocate_satellites, allocate_rate, allocate_hours, allocation_mode, planner_mode, config, thread_count);
+    }
+
+    // create the telemetry file up front (the recorder never allocates or opens anything once frames are running)
+    std::unique_ptr<Telemetry_Recorder> recorder;
+    if (record_path != nullptr) {
+        recorder.reset(new Telemetry_Recorder(record_path, static_cast<uint64_t>(record_frames)));
+        if (!recorder->is_open()) {
+            std::cerr << "ERROR: Unable to create telemetry file '" << record_path << "'" << std::endl;
+            return 1;
+        }
+    }
+
+    // allocation test drives the dashboard itself (with the recorder, if any)
+    if (allocation_test) {
+        return run_allocation_test(recorder.get());
+    }
+
+    // server mode is always headless and runs free (unless a clock was requested)
+    if (server_socket != nullptr) {
+        return run_server(server_socket, clock_set ? clock_mode : Clock_Mode::Stepped, time_scale, planner_mode, config, recorder.get());
+    }
+
+    // batch mode is always headless and runs free (unless a clock was requested)
+    if (batch_targets != nullptr) {
+        return run_batch(batch_targets, batch_results, clock_set ? clock_mode : Clock_Mode::Stepped, time_scale, planner_mode, config, recorder.get());
+    }
+
+    // sequence mode optimizes and executes a whole target queue
+    if (sequence_targets != nullptr) {
+        return run_sequence(sequence_targets, clock_mode, time_scale, headless, planner_mode, config, recorder.get());
+    }
+
+    // constellation mode steps a whole fleet without a console
+    if (constellation_count > 0) {
+        return run_constellation(constellation_count, constellation_duration, config);
+    }
+
+    // load and index the target catalog up front (lookups never allocate once frames are running)
+    Target_Catalog catalog;
+    if (catalog_path != nullptr) {
+        if (!catalog.load(catalog_path)) {
+            std::cerr << "ERROR: Unable to open target catalog '" << catalog_path << "'" << std::endl;
+            return 1;
+        }
+        std::cout << "Loaded " << catalog.size() << " catalog targets" << std::endl;
+    }
 
     // initialize the satellite object
-    Ideal_Cube_Sat sat;
+    Ideal_Cube_Sat sat(clock_mode, time_scale, headless, config);
+    sat.set_planner_mode(planner_mode);
+    sat.set_recorder(recorder.get());
+    if (catalog.size() > 0) {
+        sat.set_catalog(&catalog);
+    }
+
+    // headless loop (no console dashboard, runs until the end of input)
+    if (headless) {
+
+        // read target points until the end of input
+        double x, y, z;
+        while (std::cin >> x >> y >> z) {
+
+            // skip invalid target points
+            if (!sat.set_target(x, y, z)) {
+                std::cerr << "Skipping invalid target (0 0 0)" << std::endl;
+                continue;
+            }
+
+            // execute attitude maneuvers
+            sat.reorient();
+
+            // report where the satellite ended up
+            std::cout << x << " " << y << " " << z << " -> " << sat.curr_point.global_x << " " << sat.curr_point.global_y << " " << sat.curr_point.global_z
+                      << " (slew " << sat.last_metrics.plan.slew_time << " s, saved " << sat.last_metrics.plan.time_saved << " s)" << std::endl;
+        }
+
+        return 0;
+    }
+
+    // read user input on its own thread, so a new target typed mid-maneuver cuts the maneuver short instead of waiting for it to finish
+    Command_Queue commands;
+    sat.set_command_queue(&commands);
 
     // Write initial data to the console
-    sat.print_info("Welcome to the Ideal Cube Satellite Simulator!");
+    sat.print_info(Status_Message::Welcome);
 
-    // main update loop
+    // main update loop (runs until the user types "quit" or the input ends)
     while (true) {
-        
-        // get user input for new target point
-        sat.get_new_target();
+
+        // slew to a target typed during the last maneuver right away, otherwise get user input for new target point
+        double x, y, z;
+        if (sat.take_pending_target(x, y, z)) {
+            sat.set_target(x, y, z);
+        } else if (!sat.get_new_target()) {
+            break;
+        }
 
         // execute attitude maneuvers
         sat.reorient();
 
         // write current data to the console (removes any residual messages from maneuvers)
-        sat.print_info("");
+        sat.print_info(Status_Message::None);
 
     }
-    
+
     return 0;
-}
\ No newline at end of file
+}